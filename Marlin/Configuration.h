@@ -479,8 +479,11 @@
  * impact FET heating. This also works fine on a Fotek SSR-10DA Solid State Relay into a 250W
  * heater. If your configuration is significantly different than this and you don't understand
  * the issues involved, don't use bed PID until someone else verifies that your hardware works.
+ *
+ * On Snapmaker the bed is switched with BED_SLOW_PWM (see Configuration_adv.h), so the
+ * MOSFET sees a few edges per second instead of the soft PWM frequency.
  */
-//#define PIDTEMPBED
+#define PIDTEMPBED
 
 //#define BED_LIMIT_SWITCHING
 
@@ -496,11 +499,17 @@
 
   //#define PID_BED_DEBUG // Sends debug data to the serial port.
 
+  // Snapmaker 2.0 aluminium bed, conservative values to start with
+  // until M303 has been run on the machine
+  #define DEFAULT_bedKp 40.00
+  #define DEFAULT_bedKi 1.20
+  #define DEFAULT_bedKd 900.0
+
   //120V 250W silicone heater into 4mm borosilicate (MendelMax 1.5+)
   //from FOPDT model - kp=.39 Tp=405 Tdead=66, Tc set to 79.2, aggressive factor of .15 (vs .1, 1, 10)
-  #define DEFAULT_bedKp 10.00
-  #define DEFAULT_bedKi .023
-  #define DEFAULT_bedKd 305.4
+  //#define DEFAULT_bedKp 10.00
+  //#define DEFAULT_bedKi .023
+  //#define DEFAULT_bedKd 305.4
 
   //120V 250W silicone heater into 4mm borosilicate (MendelMax 1.5+)
   //from pidautotune
@@ -509,6 +518,7 @@
   //#define DEFAULT_bedKd 1675.16
 
   // FIND YOUR OWN: "M303 E-1 C8 S90" to run autotune on the bed at 90 degreesC for 8 cycles.
+  // "M303 E-1 C8 S70 U1" then "M500" tunes the Snapmaker bed and keeps the result.
 #endif // PIDTEMPBED
 
 // @section extruder
@@ -915,6 +925,18 @@
 // Feedrate (mm/m) for the "accurate" probe of each point
 #define Z_PROBE_SPEED_SLOW (5 * 60)
 
+/**
+ * The probe is reported over CAN, so the axis stops some time after the
+ * trigger. M1037 probes at several speeds, measures the stop scatter and
+ * the latency from the stepper counts, and recommends the fastest speeds
+ * within a repeatability target. The speeds above are the defaults.
+ */
+#define PROBE_SPEED_TUNING
+#if ENABLED(PROBE_SPEED_TUNING)
+  #define PROBE_TUNING_SIGMA      (0.005f) // (mm) default repeatability target, standard deviation
+  #define PROBE_TUNING_SAMPLES    5        // default probes at each speed
+#endif
+
 // The number of probes to perform at each point.
 //   Set to 2 for a fast/slow probe, using the second probe result.
 //   Set to 3 or more for slow probes, averaging the results.
@@ -937,6 +959,29 @@
 #define Z_CLEARANCE_DEPLOY_PROBE    40 // Z Clearance for Deploy/Stow
 #define Z_CLEARANCE_BETWEEN_PROBES  5 // Z Clearance between probe points
 #define Z_CLEARANCE_MULTI_PROBE     (1.5f) // Z Clearance between multiple probes
+
+/**
+ * Quick auto probing, used by fast calibration and G1029 A Q1
+ *
+ * Each point starts from the trigger height of the previous one, which is
+ * always a neighbour in the probing order, plus a small clearance instead of
+ * Z_CLEARANCE_BETWEEN_PROBES. One approach at Z_PROBE_SPEED_SLOW, then one
+ * slow probe from QUICK_PROBING_RECHECK above instead of MULTIPLE_PROBING.
+ * The point fails if the probe doesn't release after the raise.
+ */
+#define QUICK_AUTO_PROBING
+#if ENABLED(QUICK_AUTO_PROBING)
+  #define QUICK_PROBING_CLEARANCE   (2.0f) // (mm) above the previous trigger height
+  #define QUICK_PROBING_RECHECK     (1.5f) // (mm) raise before the slow probe, at least Z_CLEARANCE_MULTI_PROBE
+  #define QUICK_PROBING_SPEED       (0.5f) // (mm/s) the slow probe, as the repeated probes of MULTIPLE_PROBING
+#endif
+
+/**
+ * Dual extruder leveling probes the mesh quickly, and takes the left nozzle
+ * height in the same descent as the proximity switch at the center point:
+ * the module reports the switch while the nozzle sensor stops the move.
+ */
+#define DUAL_PROBE_CAPTURE
 //#define Z_AFTER_PROBING           5 // Z position after probing is done
 
 #define Z_PROBE_LOW_POINT          -2 // Farthest distance below the trigger-point to go before stopping
@@ -1263,6 +1308,16 @@ extern uint8_t E_ENABLE_ON;
   #define SEGMENT_LEVELED_MOVES
   #define LEVELED_SEGMENT_LENGTH 5.0 // (mm) Length of all segments (except the last one)
 
+  // With bilinear leveling, only split where the mesh leaves the straight
+  // line between the segment ends by more than the tolerance. Segments are
+  // never shorter than LEVELED_SEGMENT_LENGTH, so a bent bed gets the same
+  // segments as before and a flat bed gets far fewer planner blocks.
+  #define LEVELED_SEGMENT_ADAPTIVE
+  #if ENABLED(LEVELED_SEGMENT_ADAPTIVE)
+    #define LEVELED_SEGMENT_TOLERANCE  0.005 // (mm) Max Z error between the segment ends
+    #define LEVELED_SEGMENT_MAX_LENGTH 100.0 // (mm) Longest segment
+  #endif
+
   /**
    * Enable the G26 Mesh Validation Pattern tool.
    */
@@ -1288,6 +1343,28 @@ extern uint8_t E_ENABLE_ON;
 #define DEFAUT_LEVELING_HEIGHT  9 // uint: mm
 #define DEFAUT_LEVELING_HEIGHT_3DP2E  75 // uint: mm
 
+  // Keep a mesh for each toolhead and bed, and load it when they are changed. See M1035.
+  #define LEVELING_MESH_SLOTS
+  #if ENABLED(LEVELING_MESH_SLOTS)
+    #define MESH_SLOT_NUM 3
+  #endif
+
+  // Move the mesh with the bed temperature, by the drift of a few points
+  // probed at two or more temperatures. See M1036.
+  #define BED_THERMAL_DRIFT
+  #if ENABLED(BED_THERMAL_DRIFT)
+    #define THERMAL_DRIFT_TEMPS  4    // Bed temperatures kept for the fit
+    #define THERMAL_DRIFT_RANGE  10   // (°C) Don't extrapolate farther beyond the probed temperatures
+  #endif
+
+  // Re-level by probing every few points of the saved mesh, and probing the
+  // cells between them only where those points moved. See M1038.
+  #define INCREMENTAL_LEVELING
+  #if ENABLED(INCREMENTAL_LEVELING)
+    #define INCREMENTAL_LEVELING_STEP       2       // Probe every Nth point, and the last one, of each row and column
+    #define INCREMENTAL_LEVELING_THRESHOLD  0.05f   // (mm) Re-probe the cells around a point which moved more
+  #endif
+
   // Set the boundaries for probing (where the probe can reach).
   #define LEFT_PROBE_BED_POSITION 30
   #define RIGHT_PROBE_BED_POSITION (X_BED_SIZE - (10))
@@ -1312,6 +1389,14 @@ extern uint8_t E_ENABLE_ON;
       // Number of subdivisions between probe points
       #define BILINEAR_SUBDIVISIONS 3
       #define VIRTUAL_GRID_MAX_NUM ((GRID_MAX_NUM - 1) * BILINEAR_SUBDIVISIONS + 1)
+
+      // Evaluate the Catmull-Rom surface itself from bicubic coefficients
+      // cached for each grid cell, instead of the subdivided grid. Costs 64
+      // bytes of RAM per cell, the subdivided grid it replaces is freed.
+      #define ABL_BICUBIC_CACHE
+      #if ENABLED(ABL_BICUBIC_CACHE)
+        #define ABL_BICUBIC_FIXED     // Integer coefficients in 0.01µm and Q15 cell ratios, no soft-float
+      #endif
     #endif
 
   #endif
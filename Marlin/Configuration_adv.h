@@ -57,6 +57,21 @@
   #endif
 #endif
 
+/**
+ * Low frequency bed PWM
+ * Drive the bed with a time-proportioned window instead of the soft PWM of
+ * the hotends. The duty is latched at the start of each window, and on or
+ * off times shorter than BED_PWM_MIN_STATE are rounded away, so the bed
+ * MOSFET switches at most twice per window. Power 0 still turns it off at once.
+ */
+#if ENABLED(PIDTEMPBED)
+  #define BED_SLOW_PWM
+  #if ENABLED(BED_SLOW_PWM)
+    #define BED_PWM_PERIOD     1000 // (ms) Window length
+    #define BED_PWM_MIN_STATE    50 // (ms) Shortest on or off time in a window
+  #endif
+#endif
+
 /**
  * Thermal Protection provides additional protection to your printer from damage
  * and fire. Marlin always includes safe min and max temperature ranges which
@@ -158,6 +173,59 @@
   #endif
 #endif
 
+/**
+ * Hotend feed-forward
+ * The toolhead runs its own PID and cannot see the extrusion coming, so high
+ * flow moves make the temperature dip. Estimate the volumetric flow of the
+ * queued E moves and send the toolhead the heater power needed to melt it,
+ * ahead of time. Calibrate the model with M306 T, set it with M306, save it
+ * with M500.
+ */
+#define HOTEND_FEEDFORWARD
+#if ENABLED(HOTEND_FEEDFORWARD)
+  #define HOTEND_FF_INTERVAL              200   // (ms) Period of the power hint
+  #define HOTEND_FF_LOOKAHEAD            1500   // (ms) Queued motion to average the flow over
+  #define HOTEND_FF_FILAMENT_DIA         1.75   // (mm)
+  #define HOTEND_FF_HEATER_POWER        40.0f   // (W) Heater power of one hotend
+  #define HOTEND_FF_FILAMENT_HEAT_CAP  0.0023f  // (J/K/mm³) Volumetric heat capacity, 0.0023 for PLA
+  #define HOTEND_FF_AMBIENT              25.0f  // (°C) Filament temperature before melting
+  #define HOTEND_FF_CAL_FLOW              8.0f  // (mm³/s) Flow M306 T extrudes to measure the dip
+#endif
+
+/**
+ * Volumetric flow limit
+ * Slow down printing moves whose extrusion needs more melt than the hotend can
+ * give. The limit of each extruder comes from the detected nozzle type, see
+ * hotend_info, and may be changed with M1033. Retracts and primes are not limited.
+ */
+#define VOLUMETRIC_FLOW_LIMIT
+#if ENABLED(VOLUMETRIC_FLOW_LIMIT)
+  #define VOLUMETRIC_FLOW_FILAMENT_DIA   1.75   // (mm)
+  #define VOLUMETRIC_FLOW_DEFAULT        12.0f  // (mm³/s) Single extruder and unknown nozzles, 0 for no limit
+#endif
+
+/**
+ * Motion profiles keyed by the nozzle type of the dual extruder
+ *
+ * One profile for each entry of hotend_info, set with M1034 and saved with M500.
+ * The profile of the active nozzle is applied in Marlin task when the module
+ * reports its nozzle types and at tool change: print, travel and retract
+ * acceleration, FT shaping frequencies, M900 K and max volumetric flow.
+ * Fields left at 0 (-1 for K) keep the current value.
+ */
+#define NOZZLE_MOTION_PROFILE
+
+/**
+ * Event-driven heating waits
+ * While M109/M190 wait, keep moving G-code from the HMI packs and the serial
+ * port into the command queue, so it is full the moment heating is done, and
+ * sleep until a new hotend temperature arrives instead of spinning on idle().
+ */
+#define EVENT_DRIVEN_HEAT_WAIT
+#if ENABLED(EVENT_DRIVEN_HEAT_WAIT)
+  #define HEAT_WAIT_YIELD_MS  50  // (ms) Longest sleep between two checks
+#endif
+
 /**
  * Automatic Temperature:
  * The hotend target temperature is calculated by all the buffered lines of gcode.
@@ -1059,6 +1127,19 @@
 #if ENABLED(LIN_ADVANCE)
   #define LIN_ADVANCE_K 0.04  // Unit: mm compression per 1mm/s extruder speed
   //#define LA_DEBUG          // If enabled, this will generate debug information output over USB.
+
+  /**
+   * Compute the advance in the stepper block phase instead of a separate advance ISR.
+   * The advance goes out with the main step pulses, following K * E speed through a
+   * first order filter. FT motion uses the same M900 K and smoothing time, so the
+   * pressure stays consistent when M493 switches between the two stepper paths.
+   * M900 without parameters reports the advance and main ISR counts since the last report.
+   */
+  #define LIN_ADVANCE_UNIFIED
+  #if ENABLED(LIN_ADVANCE_UNIFIED)
+    #define LIN_ADVANCE_SMOOTH_TIME   0.004 // (s) Time constant of the advance filter
+    #define LIN_ADVANCE_STEPS_PER_ISR 4     // Max advance steps added in one block phase
+  #endif
 #endif
 
 // @section leveling
@@ -1098,13 +1179,99 @@
 #if ENABLED(ARC_SUPPORT)
   #define MM_PER_ARC_SEGMENT  1   // Length of each arc segment
   #define MIN_ARC_SEGMENTS   24   // Minimum number of segments in a complete circle
+
+  /**
+   * Adaptive arc segmentation.
+   * Pick the segment length from the allowed chord-to-arc deviation instead of
+   * using a fixed MM_PER_ARC_SEGMENT. Large radius arcs get long segments (fewer
+   * planner blocks, longer lookahead), small radius arcs keep their accuracy.
+   * ARC_SEGMENTS_PER_SEC stretches the segments at high feedrates so the planner
+   * buffer is never drained faster than it can be filled.
+   */
+  #define ARC_CHORDAL_TOLERANCE
+  #if ENABLED(ARC_CHORDAL_TOLERANCE)
+    #define ARC_CHORDAL_ERROR_MM   0.005  // (mm) Maximum deviation of a segment from the true arc
+    #define MIN_ARC_SEGMENT_MM     0.1    // (mm) Shortest segment length
+    #define MAX_ARC_SEGMENT_MM     5      // (mm) Longest segment length
+    #define ARC_SEGMENTS_PER_SEC 150      // Maximum rate of segments fed to the planner
+  #endif
   #define N_ARC_CORRECTION   25   // Number of interpolated segments between corrections
   //#define ARC_P_CIRCLES         // Enable the 'P' parameter to specify complete circles
   //#define CNC_WORKSPACE_PLANES  // Allow G2/G3 to operate in XY, ZX, or YZ planes
 #endif
 
+/**
+ * Mid-line resume
+ *
+ * When a pause, filament runout or power loss stops a move, record the steps
+ * left to the end of its G-code line. Resume runs them from the stop point
+ * and the host goes on from the next line, instead of running the interrupted
+ * line again, which over-extrudes with relative E and after G92.
+ */
+#define RESUME_LINE_REMAINDER
+
+/**
+ * Collinear move coalescing
+ *
+ * Merge runs of G0/G1 segments that lie on the same line into a single
+ * planner move. Laser rasters and finely sliced models produce many tiny
+ * collinear segments, each costing a planner block and a lookahead pass.
+ * Segments are only merged when feedrate, extrusion ratio and inline laser
+ * power are unchanged. Use M1030 to toggle and tune at runtime.
+ */
+#define MOVE_COALESCING
+#if ENABLED(MOVE_COALESCING)
+  #define MOVE_COALESCE_CHORDAL_TOLERANCE  0.002 // (mm) Max distance of a merged point from the run direction
+  #define MOVE_COALESCE_ANGULAR_TOLERANCE  0.5   // (°) Max angle between a segment and the run direction
+  #define MOVE_COALESCE_MAX_LENGTH        50     // (mm) Longest merged move, bounds power-loss resume granularity
+#endif
+
+/**
+ * Laser focus sweep
+ *
+ * Auto focusing queues the whole focus ruler at once: each Z step is made
+ * with the travel to the next line, and the laser power of every move is
+ * carried by its planner block. The head doesn't stop between lines, and
+ * no CAN power command is sent per line.
+ */
+#define LASER_FOCUS_SWEEP
+
+/**
+ * Laser raster mode
+ *
+ * G7 engraves one scanline whose pixel powers arrive as a binary array in an
+ * SSTP event (EID_CAMERA_REQ : CAMERA_OPC_LASER_RASTER_DATA), instead of one
+ * G1 S<power> command per pixel. The whole line is a single planner block and
+ * the stepper ISR picks the power of each pixel by its step count.
+ */
+#define LASER_RASTER_MODE
+#if ENABLED(LASER_RASTER_MODE)
+  #define LASER_RASTER_MAX_PIXELS   1024  // Longest scanline, bytes per slot
+  #define LASER_RASTER_SLOTS        2     // Lines buffered ahead of the stepper, at least 2
+  #define LASER_RASTER_DATA_TIMEOUT 5000  // (ms) How long G7 waits for its pixel data
+#endif
+
+/**
+ * Job alignment
+ *
+ * M1040 rotates and moves the following job in XY to fit a workpiece placed
+ * on the bed, from reference marks seen by the camera or under the head.
+ * The transform is applied in the planner, before leveling, so G-code,
+ * soft endstops and M114 stay in job coordinates.
+ *
+ * M1039 keeps the camera-to-machine calibration in EEPROM. The crosslight
+ * offset last read from the laser module is kept there too, and used when
+ * the module doesn't answer.
+ */
+#define JOB_ALIGNMENT
+
 // Support for G5 with XYZE destination and IJPQ offsets. Requires ~2666 bytes.
-//#define BEZIER_CURVE_SUPPORT
+#define BEZIER_CURVE_SUPPORT
+#if ENABLED(BEZIER_CURVE_SUPPORT)
+  #define BEZIER_CHORDAL_ERROR_MM  0.01 // (mm) Maximum deviation of a segment from the curve
+  #define BEZIER_MIN_SEGMENT_MM    0.1  // (mm) Shortest segment, unless the curve itself is shorter
+  #define BEZIER_MAX_SEGMENT_MM    5    // (mm) Longest segment, keeps leveled moves following the mesh
+#endif
 
 /**
  * G38 Probe Target
@@ -1316,6 +1483,22 @@
     #define TOOLCHANGE_PARK_XY    { X_MIN_POS + 10, Y_MIN_POS + 10 }
     #define TOOLCHANGE_PARK_XY_FEEDRATE 6000  // (mm/m)
   #endif
+
+  /**
+   * Keep the idle nozzle of the dual extruder at a standby temperature, and
+   * heat it back to its print temperature just in time for the next T command
+   * found in the queued G-code. The time to the swap is estimated from the
+   * planner and the moves in the queues, so the standby drop should be small
+   * enough to recover within that lookahead. A tool change still waits for
+   * the new nozzle if it is not back in time. Use M1031 to tune at runtime.
+   */
+  #define IDLE_NOZZLE_PREHEAT
+  #if ENABLED(IDLE_NOZZLE_PREHEAT)
+    #define IDLE_NOZZLE_PREHEAT_ENABLED false  // Off until turned on by M1031 S1
+    #define IDLE_NOZZLE_STANDBY_DROP   30  // (°C) Standby temperature below the print temperature
+    #define IDLE_NOZZLE_HEAT_RATE     2.0  // (°C/s) Expected heating rate of a nozzle
+    #define IDLE_NOZZLE_HEAT_MARGIN     3  // (s) Start heating this much earlier
+  #endif
 #endif
 
 /**
@@ -2020,6 +2203,20 @@
  */
 #define AUTO_REPORT_TEMPERATURES
 
+/**
+ * Keep the hotend temperatures reported by the toolhead over CAN as
+ * timestamped samples, and ask the module for a faster report rate if it
+ * supports it. A heating hotend without fresh samples is treated as a bad
+ * sensor. Stream the samples with M1032 S<ms>; the HMI subscribes to the
+ * same stream with SYSCTL_OPC_SET_TEMP_REPORT. No extra CAN polling is done.
+ */
+#define HOTEND_TEMP_TELEMETRY
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+  #define HOTEND_TEMP_HISTORY_SIZE     16  // Samples kept per hotend
+  #define HOTEND_TEMP_REPORT_INTERVAL 100  // (ms) Report interval asked from the module
+  #define HOTEND_TEMP_STALE_TIME     5000  // (ms) Age of the last sample to call the sensor lost
+#endif
+
 /**
  * Include capabilities in M115 output
  */
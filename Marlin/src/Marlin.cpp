@@ -61,6 +61,10 @@
 
 #include "snapmaker.h"
 #include "module/linear.h"
+#include "../../snapmaker/src/service/temp_telemetry.h"
+#include "../../snapmaker/src/service/nozzle_profile.h"
+#include "../../snapmaker/src/service/thermal_drift.h"
+#include "../../snapmaker/src/service/hotend_feedforward.h"
 
 #if ENABLED(HOST_ACTION_COMMANDS)
   #include "feature/host_actions.h"
@@ -853,11 +857,26 @@ void idle(
     HAL_idletask();
   #endif
 
+  #if ENABLED(NOZZLE_MOTION_PROFILE)
+    nozzle_profile.Process();
+  #endif
+
+  #if ENABLED(BED_THERMAL_DRIFT)
+    thermal_drift.Process();
+  #endif
+
+  #if ENABLED(HOTEND_FEEDFORWARD)
+    hotend_ff.Update();
+  #endif
+
   #if HAS_AUTO_REPORTING
     if (!suspend_auto_report) {
       #if ENABLED(AUTO_REPORT_TEMPERATURES)
         thermalManager.auto_report_temperatures();
       #endif
+      #if ENABLED(HOTEND_TEMP_TELEMETRY)
+        temp_telemetry.Process();
+      #endif
       #if ENABLED(AUTO_REPORT_SD_STATUS)
         card.auto_report_sd_status();
       #endif
@@ -41,6 +41,14 @@ float bilinear_grid_factor[2],
 // nozzle height when probed bed, will initialize by settings.load()
 float nozzle_height_probed = 0;
 
+#if ENABLED(BED_THERMAL_DRIFT)
+  // plane added to the mesh for the bed temperature, set by ThermalDrift
+  float bilinear_drift[3] = { 0 };
+  #define ABL_DRIFT(R) (bilinear_drift[0] + bilinear_drift[1] * (R)[X_AXIS] + bilinear_drift[2] * (R)[Y_AXIS])
+#else
+  #define ABL_DRIFT(R) 0
+#endif
+
 /**
  * Extrapolate a single point from its neighbors
  */
@@ -159,16 +167,19 @@ void print_bilinear_leveling_grid() {
   extern uint32_t ABL_TEMP_POINTS_X;
   extern uint32_t ABL_TEMP_POINTS_Y;
 
-  float z_values_virt[VIRTUAL_GRID_MAX_NUM][VIRTUAL_GRID_MAX_NUM];
-  int bilinear_grid_spacing_virt[2] = { 0 };
-  float bilinear_grid_factor_virt[2] = { 0 };
-
-  void print_bilinear_leveling_grid_virt() {
-    SERIAL_ECHOLNPGM("Subdivided with CATMULL ROM Leveling Grid:");
-    print_2d_array(ABL_GRID_POINTS_VIRT_X, ABL_GRID_POINTS_VIRT_Y, 5,
-      [](const uint8_t ix, const uint8_t iy) { return z_values_virt[ix][iy]; }
-    );
-  }
+  // with ABL_BICUBIC_CACHE the cached patches replace the subdivided grid
+  #if DISABLED(ABL_BICUBIC_CACHE)
+    float z_values_virt[VIRTUAL_GRID_MAX_NUM][VIRTUAL_GRID_MAX_NUM];
+    int bilinear_grid_spacing_virt[2] = { 0 };
+    float bilinear_grid_factor_virt[2] = { 0 };
+
+    void print_bilinear_leveling_grid_virt() {
+      SERIAL_ECHOLNPGM("Subdivided with CATMULL ROM Leveling Grid:");
+      print_2d_array(ABL_GRID_POINTS_VIRT_X, ABL_GRID_POINTS_VIRT_Y, 5,
+        [](const uint8_t ix, const uint8_t iy) { return z_values_virt[ix][iy]; }
+      );
+    }
+  #endif
 
   #define LINEAR_EXTRAPOLATION(E, I) ((E) * 2 - (I))
   float bed_level_virt_coord(const uint8_t x, const uint8_t y) {
@@ -208,6 +219,8 @@ void print_bilinear_leveling_grid() {
     return z_values[x - 1][y - 1];
   }
 
+  #if DISABLED(ABL_BICUBIC_CACHE)
+
   static float bed_level_virt_cmr(const float p[4], const uint8_t i, const float t) {
     return (
         p[i-1] * -t * sq(1 - t)
@@ -228,7 +241,142 @@ void print_bilinear_leveling_grid() {
     return bed_level_virt_cmr(row, 1, tx);
   }
 
+  #else // ABL_BICUBIC_CACHE
+
+    #if ENABLED(ABL_BICUBIC_FIXED)
+      #define BICUBIC_Z_SCALE   100000.0f   // coefficient units per mm
+      #define BICUBIC_T_SHIFT   15
+      typedef int32_t bicubic_coeff_t;
+    #else
+      typedef float bicubic_coeff_t;
+    #endif
+
+    // z = sum of a[i][j] * u^i * v^j in cell (x, y), u and v are the ratios within the cell
+    static bicubic_coeff_t bicubic_coeff[GRID_MAX_NUM - 1][GRID_MAX_NUM - 1][4][4];
+    static float bicubic_factor[2];
+    static bool bicubic_valid = false;
+
+    // Catmull-Rom basis, times 2
+    static const int8_t cmr_basis[4][4] = {
+      {  0,  2,  0,  0 },
+      { -1,  0,  1,  0 },
+      {  2, -5,  4, -1 },
+      { -1,  3, -3,  1 }
+    };
+
+    static void bicubic_cache_build() {
+      bicubic_valid = false;
+      if (GRID_MAX_POINTS_X < 2 || GRID_MAX_POINTS_Y < 2 || !bilinear_grid_spacing[X_AXIS] || !bilinear_grid_spacing[Y_AXIS])
+        return;
+
+      bicubic_factor[X_AXIS] = RECIPROCAL(bilinear_grid_spacing[X_AXIS]);
+      bicubic_factor[Y_AXIS] = RECIPROCAL(bilinear_grid_spacing[Y_AXIS]);
+
+      for (uint8_t x = 0; x < GRID_MAX_POINTS_X - 1; x++)
+        for (uint8_t y = 0; y < GRID_MAX_POINTS_Y - 1; y++) {
+          // 4x4 control points around the cell, extrapolated at the edges as the virtual grid
+          float p[4][4], mp[4][4];
+          for (uint8_t i = 0; i < 4; i++)
+            for (uint8_t j = 0; j < 4; j++)
+              p[i][j] = bed_level_virt_coord(x + i, y + j);
+
+          // a = M * P * M^T / 4
+          for (uint8_t i = 0; i < 4; i++)
+            for (uint8_t j = 0; j < 4; j++) {
+              mp[i][j] = 0;
+              for (uint8_t k = 0; k < 4; k++) mp[i][j] += cmr_basis[i][k] * p[k][j];
+            }
+          for (uint8_t i = 0; i < 4; i++)
+            for (uint8_t j = 0; j < 4; j++) {
+              float a = 0;
+              for (uint8_t k = 0; k < 4; k++) a += mp[i][k] * cmr_basis[j][k];
+              a *= 0.25f;
+              #if ENABLED(ABL_BICUBIC_FIXED)
+                bicubic_coeff[x][y][i][j] = LROUND(a * (BICUBIC_Z_SCALE));
+              #else
+                bicubic_coeff[x][y][i][j] = a;
+              #endif
+            }
+        }
+
+      bicubic_valid = true;
+    }
+
+    // Z of the cached patch, ratios in grid cells from the first probed point, within the probed area
+    static float bicubic_patch(const float ratio_x, const float ratio_y) {
+      const uint8_t gx = MIN(uint8_t(ratio_x), uint8_t(GRID_MAX_POINTS_X - 2)),
+                    gy = MIN(uint8_t(ratio_y), uint8_t(GRID_MAX_POINTS_Y - 2));
+      const bicubic_coeff_t (&a)[4][4] = bicubic_coeff[gx][gy];
+
+      // Horner in v for each power of u, then in u
+      #if ENABLED(ABL_BICUBIC_FIXED)
+        const int32_t u = LROUND((ratio_x - gx) * (1 << BICUBIC_T_SHIFT)),
+                      v = LROUND((ratio_y - gy) * (1 << BICUBIC_T_SHIFT));
+        int64_t r = 0;
+        for (int8_t i = 3; i >= 0; i--) {
+          int64_t c = a[i][3];
+          c = a[i][2] + ((c * v) >> BICUBIC_T_SHIFT);
+          c = a[i][1] + ((c * v) >> BICUBIC_T_SHIFT);
+          c = a[i][0] + ((c * v) >> BICUBIC_T_SHIFT);
+          r = c + ((r * u) >> BICUBIC_T_SHIFT);
+        }
+        return r * (1.0f / (BICUBIC_Z_SCALE));
+      #else
+        const float u = ratio_x - gx, v = ratio_y - gy;
+        float r = 0;
+        for (int8_t i = 3; i >= 0; i--)
+          r = r * u + (((a[i][3] * v + a[i][2]) * v + a[i][1]) * v + a[i][0]);
+        return r;
+      #endif
+    }
+
+    /**
+     * Z offset from the cached patches, false if they are not built.
+     * The cubic must not be extrapolated, so beyond the probed area go on
+     * from the edge along the slope of its last subdivision, as the
+     * subdivided grid did.
+     */
+    static bool bicubic_z_offset(const float raw[XYZ], float &z) {
+      if (!bicubic_valid) return false;
+
+      const float ratio_x = (raw[X_AXIS] - bilinear_start[X_AXIS]) * bicubic_factor[X_AXIS],
+                  ratio_y = (raw[Y_AXIS] - bilinear_start[Y_AXIS]) * bicubic_factor[Y_AXIS],
+                  edge_x = constrain(ratio_x, 0, GRID_MAX_POINTS_X - 1),
+                  edge_y = constrain(ratio_y, 0, GRID_MAX_POINTS_Y - 1);
+
+      const float z_edge = bicubic_patch(edge_x, edge_y);
+      z = z_edge;
+
+      #if ENABLED(EXTRAPOLATE_BEYOND_GRID)
+        constexpr float step = 1.0f / (BILINEAR_SUBDIVISIONS);
+        if (ratio_x != edge_x) {
+          const float in = ratio_x < edge_x ? step : -step;
+          z += (z_edge - bicubic_patch(edge_x + in, edge_y)) * ABS(ratio_x - edge_x) * (BILINEAR_SUBDIVISIONS);
+        }
+        if (ratio_y != edge_y) {
+          const float in = ratio_y < edge_y ? step : -step;
+          z += (z_edge - bicubic_patch(edge_x, edge_y + in)) * ABS(ratio_y - edge_y) * (BILINEAR_SUBDIVISIONS);
+        }
+      #endif
+
+      return true;
+    }
+
+    void print_bilinear_leveling_grid_virt() {
+      SERIAL_ECHOLNPGM("Subdivided with CATMULL ROM Leveling Grid:");
+      print_2d_array(ABL_GRID_POINTS_VIRT_X, ABL_GRID_POINTS_VIRT_Y, 5,
+        [](const uint8_t ix, const uint8_t iy) {
+          return bicubic_valid ? bicubic_patch(float(ix) / (BILINEAR_SUBDIVISIONS), float(iy) / (BILINEAR_SUBDIVISIONS)) : NAN;
+        }
+      );
+    }
+
+  #endif // ABL_BICUBIC_CACHE
+
   void bed_level_virt_interpolate() {
+    #if ENABLED(ABL_BICUBIC_CACHE)
+      bicubic_cache_build();
+    #else
     bilinear_grid_spacing_virt[X_AXIS] = bilinear_grid_spacing[X_AXIS] / (BILINEAR_SUBDIVISIONS);
     bilinear_grid_spacing_virt[Y_AXIS] = bilinear_grid_spacing[Y_AXIS] / (BILINEAR_SUBDIVISIONS);
     bilinear_grid_factor_virt[X_AXIS] = RECIPROCAL(bilinear_grid_spacing_virt[X_AXIS]);
@@ -247,6 +395,7 @@ void print_bilinear_leveling_grid() {
                 (float)ty / (BILINEAR_SUBDIVISIONS)
               );
           }
+    #endif
   }
 #endif // ABL_BILINEAR_SUBDIVISION
 
@@ -259,7 +408,7 @@ void refresh_bed_level() {
   #endif
 }
 
-#if ENABLED(ABL_BILINEAR_SUBDIVISION)
+#if ENABLED(ABL_BILINEAR_SUBDIVISION) && DISABLED(ABL_BICUBIC_CACHE)
   #define ABL_BG_SPACING(A) bilinear_grid_spacing_virt[A]
   #define ABL_BG_FACTOR(A)  bilinear_grid_factor_virt[A]
   #define ABL_BG_POINTS_X   ABL_GRID_POINTS_VIRT_X
@@ -276,6 +425,11 @@ void refresh_bed_level() {
 // Get the Z adjustment for non-linear bed leveling
 float bilinear_z_offset(const float raw[XYZ]) {
 
+  #if ENABLED(ABL_BICUBIC_CACHE)
+    float z;
+    if (bicubic_z_offset(raw, z)) return z + ABL_DRIFT(raw);
+  #endif
+
   static float z1, d2, z3, d4, L, D, ratio_x, ratio_y,
                last_x = -999.999, last_y = -999.999;
 
@@ -358,7 +512,7 @@ float bilinear_z_offset(const float raw[XYZ]) {
   last_offset = offset;
   //*/
 
-  return offset;
+  return offset + ABL_DRIFT(raw);
 }
 
 #if IS_CARTESIAN && DISABLED(SEGMENT_LEVELED_MOVES)
@@ -478,7 +632,7 @@ void bilinear_grid_manual()
 
 
 bool visited[GRID_MAX_NUM][GRID_MAX_NUM];
-uint8_t auto_probing(bool reply_screen, bool fast_leveling) {
+uint8_t auto_probing(bool reply_screen, bool fast_leveling, bool quick_probing/* = false*/) {
   uint8_t ret = E_SUCCESS;
   bilinear_grid_manual();
 
@@ -495,6 +649,13 @@ uint8_t auto_probing(bool reply_screen, bool fast_leveling) {
   for (uint32_t k = 0; k < GRID_MAX_POINTS_X * GRID_MAX_POINTS_Y; ++k) {
     LOG_I("Probing No. %d\n", k);
 
+    #if ENABLED(QUICK_AUTO_PROBING)
+      // points in the spiral are neighbours, start from where the last one triggered
+      if (quick_probing)
+        z = probe_pt_quick(_GET_MESH_X(cur_x), _GET_MESH_Y(cur_y),
+                           k ? current_position[Z_AXIS] + QUICK_PROBING_CLEARANCE : current_position[Z_AXIS]);
+      else
+    #endif
     if (k < (GRID_MAX_POINTS_X * GRID_MAX_POINTS_Y - 1))
       z = probe_pt(_GET_MESH_X(cur_x), _GET_MESH_Y(cur_y), PROBE_PT_RAISE); // raw position
     else
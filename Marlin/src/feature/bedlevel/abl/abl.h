@@ -29,6 +29,9 @@ extern int bilinear_grid_spacing[2], bilinear_start[2];
 extern float bilinear_grid_factor[2],
              z_values[GRID_MAX_NUM][GRID_MAX_NUM];
 float bilinear_z_offset(const float raw[XYZ]);
+#if ENABLED(BED_THERMAL_DRIFT)
+  extern float bilinear_drift[3];
+#endif
 void bilinear_grid_manual();
 
 void extrapolate_unprobed_bed_level();
@@ -51,7 +54,7 @@ void refresh_bed_level();
 extern float nozzle_height_probed;
 
 
-uint8_t auto_probing(bool reply_screen, bool fast_leveling);
+uint8_t auto_probing(bool reply_screen, bool fast_leveling, bool quick_probing = false);
 void compensate_offset();
 void compensate_offset(float offset);
 void get_center_coordinates_of_bed(float &x, float &y);
@@ -53,6 +53,8 @@ extern float nozzle_height_probed;
  *
  *  A
  *              start auto probing
+ *      Q[1]
+ *              quick probing, one probe for each point from a low height
  *
  *  S
  *              tuning and saving the offset
@@ -123,7 +125,7 @@ void GcodeSuite::G1029() {
     planner.settings.max_feedrate_mm_s[Z_AXIS] = 40;
 
     endstops.enable_z_probe(true);
-    auto_probing(false, false);
+    auto_probing(false, false, parser.boolval('Q'));
     endstops.enable_z_probe(false);
 
     // Recover the Z max feedrate to 20mm/s
@@ -59,10 +59,15 @@
 #if (MOTHERBOARD == BOARD_SNAPMAKER_2_0)
   #include "../snapmaker/src/module/toolhead_3dp.h"
   #include "../snapmaker/src/service/bed_level.h"
+  #include "../snapmaker/src/service/system.h"
   #include "../snapmaker/src/module/linear.h"
   #include "../snapmaker/src/module/toolhead_laser.h"
 #endif
 
+#if ENABLED(JOB_ALIGNMENT)
+  #include "../snapmaker/src/service/job_align.h"
+#endif
+
 #if ENABLED(QUICK_HOME)
 
   static void quick_home_xy() {
@@ -251,6 +256,11 @@ void GcodeSuite::G28(const bool always_home_all) {
     set_bed_leveling_enabled(false);
   #endif
 
+  // Home in machine XY, the job is aligned again after
+  #if ENABLED(JOB_ALIGNMENT)
+    const bool job_was_aligned = job_align.Suspend();
+  #endif
+
   #if ENABLED(CNC_WORKSPACE_PLANES)
     workspace_plane = PLANE_XY;
   #endif
@@ -496,7 +506,8 @@ void GcodeSuite::G28(const bool always_home_all) {
 
       if (!parser.boolval('N')) {
         if (actual_extruder != active_extruder) {
-          printer1->ToolChange(actual_extruder);
+          if (printer1->ToolChange(actual_extruder) != E_SUCCESS)
+            systemservice.PauseTrigger(TRIGGER_SOURCE_EXCEPTION);
         }
       }
     }
@@ -504,6 +515,10 @@ void GcodeSuite::G28(const bool always_home_all) {
 
   clean_up_after_endstop_or_probe_move();
 
+  #if ENABLED(JOB_ALIGNMENT)
+    if (job_was_aligned) job_align.Resume();
+  #endif
+
   // Restore the active tool after homing
   #if HOTENDS > 1 && (DISABLED(DELTA) || ENABLED(DELTA_HOME_TO_SAFE_ZONE))
     #if ENABLED(PARKING_EXTRUDER)
@@ -23,6 +23,7 @@
 #include "../gcode.h"
 #include "../../module/tool_change.h"
 #include "../../../../snapmaker/src/module/toolhead_3dp.h"
+#include "../../../../snapmaker/src/service/system.h"
 
 #if ENABLED(DEBUG_LEVELING_FEATURE) || EXTRUDERS > 1
   #include "../../module/motion.h"
@@ -67,7 +68,11 @@ void GcodeSuite::T(const uint8_t tool_index) {
 
   #else
 
-    printer1->ToolChange(tool_index);
+    if (printer1->ToolChange(tool_index) != E_SUCCESS) {
+      // PauseTrigger() waits for tool change to finish, it has finished here
+      systemservice.tool_changing = false;
+      systemservice.PauseTrigger(TRIGGER_SOURCE_EXCEPTION);
+    }
     // tool_change(
     //   tool_index,
     //   MMM_TO_MMS(parser.linearval('F')),
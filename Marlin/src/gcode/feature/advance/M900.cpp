@@ -32,6 +32,8 @@
  * M900: Get or Set Linear Advance K-factor
  *
  *  K<factor>   Set advance K factor
+ *
+ * Without K, report the K factors and the advance and main ISR runs since the last report.
  */
 void GcodeSuite::M900() {
 
@@ -66,6 +68,11 @@ void GcodeSuite::M900() {
       }
       SERIAL_EOL();
     #endif
+
+    // ISR load since the last report, to compare the stepper paths
+    SERIAL_ECHO_START();
+    SERIAL_ECHOLNPAIR("Advance ISR: ", stepper.LA_isr_count, " Main ISR: ", stepper.LA_main_isr_count);
+    stepper.LA_isr_count = stepper.LA_main_isr_count = 0;
   }
 }
 
@@ -245,6 +245,10 @@ void GcodeSuite::M493() {
     }
 
     // Pressure control (linear advance) gain parameter.
+    #if ENABLED(LIN_ADVANCE_UNIFIED)
+      if (parser.seenval('K'))
+        SERIAL_ECHOLNPGM("Linear Advance gain is set by M900 K.");
+    #else
     if (parser.seenval('K')) {
       const float val = parser.value_float();
       if (val >= 0.0f) {
@@ -254,6 +258,7 @@ void GcodeSuite::M493() {
       else // Value out of range.
         SERIAL_ECHOLN("Linear Advance gain out of range.");
     }
+    #endif
 
   #endif // HAS_EXTRUDERS
 
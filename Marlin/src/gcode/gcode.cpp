@@ -52,6 +52,10 @@ GcodeSuite gcode;
   #include "../../../snapmaker/src/common/debug.h"
 #endif
 
+#if ENABLED(MOVE_COALESCING)
+  #include "../module/move_coalescer.h"
+#endif
+
 #include "../Marlin.h" // for idle() and suspend_auto_report
 #include "../../../snapmaker/src/hmi/gcode_result_handler.h"
 
@@ -287,6 +291,11 @@ extern bool ok_to_HMI();
 void GcodeSuite::execute_command(void) {
   KEEPALIVE_STATE(IN_HANDLER);
 
+  #if ENABLED(MOVE_COALESCING)
+    // Only G0/G1 may run while a coalesced move is held back from the planner
+    if (parser.command_letter != 'G' || parser.codenum > 1) coalescer.flush();
+  #endif
+
   // Handle a known G, M, or T
   switch (parser.command_letter) {
     case 'G': switch (parser.codenum) {
@@ -308,6 +317,10 @@ void GcodeSuite::execute_command(void) {
         case 5: G5(); break;                                      // G5: Cubic B_spline
       #endif
 
+      #if ENABLED(LASER_RASTER_MODE)
+        case 7: G7(); break;                                      // G7: Laser raster scanline
+      #endif
+
       #if ENABLED(FWRETRACT)
         case 10: G10(); break;                                    // G10: Retract / Swap Retract
         case 11: G11(); break;                                    // G11: Recover / Swap Recover
@@ -700,6 +713,10 @@ void GcodeSuite::execute_command(void) {
         case 303: M303(); break;                                  // M303: PID autotune
       #endif
 
+      #if ENABLED(HOTEND_FEEDFORWARD)
+        case 306: M306(); break;                                  // M306: Hotend thermal model and feed-forward
+      #endif
+
       #if ENABLED(MORGAN_SCARA)
         case 360: if (M360()) if(ok_to_HMI() == false) return; break;                      // M360: SCARA Theta pos1
         case 361: if (M361()) if(ok_to_HMI() == false) return; break;                      // M361: SCARA Theta pos2
@@ -913,6 +930,47 @@ void GcodeSuite::execute_command(void) {
       case 1028: M1028(); break;
       case 1029: M1029(); break;
 
+      #if ENABLED(MOVE_COALESCING)
+        case 1030: M1030(); break;                                // M1030: Collinear move coalescing
+      #endif
+
+      #if ENABLED(IDLE_NOZZLE_PREHEAT)
+        case 1031: M1031(); break;                                // M1031: Idle nozzle preheat
+      #endif
+
+      #if ENABLED(HOTEND_TEMP_TELEMETRY)
+        case 1032: M1032(); break;                                // M1032: Hotend temperature telemetry
+      #endif
+
+      #if ENABLED(VOLUMETRIC_FLOW_LIMIT)
+        case 1033: M1033(); break;                                // M1033: Volumetric flow limit
+      #endif
+
+      #if ENABLED(NOZZLE_MOTION_PROFILE)
+        case 1034: M1034(); break;                                // M1034: Nozzle motion profile
+      #endif
+
+      #if ENABLED(LEVELING_MESH_SLOTS)
+        case 1035: M1035(); break;                                // M1035: Leveling mesh slots
+      #endif
+
+      #if ENABLED(BED_THERMAL_DRIFT)
+        case 1036: M1036(); break;                                // M1036: Bed thermal drift
+      #endif
+
+      #if ENABLED(PROBE_SPEED_TUNING)
+        case 1037: M1037(); break;                                // M1037: Probe speed tuning
+      #endif
+
+      #if ENABLED(INCREMENTAL_LEVELING)
+        case 1038: M1038(); break;                                // M1038: Incremental leveling
+      #endif
+
+      #if ENABLED(JOB_ALIGNMENT)
+        case 1039: M1039(); break;                                // M1039: Camera calibration
+        case 1040: M1040(); break;                                // M1040: Job alignment
+      #endif
+
       case 1999: M1999(); break;
 
       case 2000: M2000(); break;
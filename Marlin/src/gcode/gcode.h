@@ -184,6 +184,7 @@
  * M302 - Allow cold extrudes, or set the minimum extrude S<temperature>. (Requires PREVENT_COLD_EXTRUSION)
  * M303 - PID relay autotune S<temperature> sets the target temperature. Default 150C. (Requires PIDTEMP)
  * M304 - Set bed PID parameters P I and D. (Requires PIDTEMPBED)
+ * M306 - Hotend thermal model for feed-forward, T to calibrate. (Requires HOTEND_FEEDFORWARD)
  * M350 - Set microstepping mode. (Requires digital microstepping pins.)
  * M351 - Toggle MS1 MS2 pins directly. (Requires digital microstepping pins.)
  * M355 - Set Case Light on/off and set brightness. (Requires CASE_LIGHT_PIN)
@@ -366,6 +367,10 @@ private:
     static void G5();
   #endif
 
+  #if ENABLED(LASER_RASTER_MODE)
+    static void G7();
+  #endif
+
   #if ENABLED(FWRETRACT)
     static void G10();
     static void G11();
@@ -704,6 +709,10 @@ private:
     static void M304();
   #endif
 
+  #if ENABLED(HOTEND_FEEDFORWARD)
+    static void M306();
+  #endif
+
   #if HAS_MICROSTEPS
     static void M350();
     static void M351();
@@ -905,6 +914,47 @@ private:
   static void M1028();
   static void M1029();
 
+  #if ENABLED(MOVE_COALESCING)
+    static void M1030();
+  #endif
+
+  #if ENABLED(IDLE_NOZZLE_PREHEAT)
+    static void M1031();
+  #endif
+
+  #if ENABLED(HOTEND_TEMP_TELEMETRY)
+    static void M1032();
+  #endif
+
+  #if ENABLED(VOLUMETRIC_FLOW_LIMIT)
+    static void M1033();
+  #endif
+
+  #if ENABLED(NOZZLE_MOTION_PROFILE)
+    static void M1034();
+  #endif
+
+  #if ENABLED(LEVELING_MESH_SLOTS)
+    static void M1035();
+  #endif
+
+  #if ENABLED(BED_THERMAL_DRIFT)
+    static void M1036();
+  #endif
+
+  #if ENABLED(PROBE_SPEED_TUNING)
+    static void M1037();
+  #endif
+
+  #if ENABLED(INCREMENTAL_LEVELING)
+    static void M1038();
+  #endif
+
+  #if ENABLED(JOB_ALIGNMENT)
+    static void M1039();
+    static void M1040();
+  #endif
+
   static void M1999();
 
   static void M2000();
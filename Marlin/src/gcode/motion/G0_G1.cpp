@@ -34,6 +34,10 @@
   #include "../../module/stepper.h"
 #endif
 
+#if ENABLED(MOVE_COALESCING)
+  #include "../../module/move_coalescer.h"
+#endif
+
 extern float destination[X_TO_E];
 
 #if ENABLED(VARIABLE_G0_FEEDRATE)
@@ -104,6 +108,8 @@ void GcodeSuite::G0_G1(
 
     #if IS_SCARA
       fast_move ? prepare_uninterpolated_move_to_destination() : prepare_move_to_destination();
+    #elif ENABLED(MOVE_COALESCING)
+      if (!coalescer.add()) prepare_move_to_destination();
     #else
       prepare_move_to_destination();
     #endif
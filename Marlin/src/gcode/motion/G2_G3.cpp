@@ -40,11 +40,33 @@
   #define N_ARC_CORRECTION 1
 #endif
 
+#if ENABLED(ARC_CHORDAL_TOLERANCE)
+
+  /**
+   * Length of the longest chord that stays within ARC_CHORDAL_ERROR_MM of
+   * an arc with the given radius, stretched so that no more than
+   * ARC_SEGMENTS_PER_SEC segments are needed at the given feedrate.
+   */
+  static float arc_segment_length(const float radius, const float fr_mm_s) {
+    float seg_length = MAX_ARC_SEGMENT_MM;
+    if (radius > (ARC_CHORDAL_ERROR_MM))
+      seg_length = 2 * SQRT((2 * radius - (ARC_CHORDAL_ERROR_MM)) * (ARC_CHORDAL_ERROR_MM));
+    #ifdef ARC_SEGMENTS_PER_SEC
+      NOLESS(seg_length, fr_mm_s * (1.0f / (ARC_SEGMENTS_PER_SEC)));
+    #else
+      UNUSED(fr_mm_s);
+    #endif
+    return constrain(seg_length, MIN_ARC_SEGMENT_MM, MAX_ARC_SEGMENT_MM);
+  }
+
+#endif
+
 /**
  * Plan an arc in 2 dimensions
  *
  * The arc is approximated by generating many small linear segments.
  * The length of each segment is configured in MM_PER_ARC_SEGMENT (Default 1mm)
+ * or, with ARC_CHORDAL_TOLERANCE, derived from the arc radius and feedrate.
  * Arcs should only be made relatively large (over 5mm), as larger arcs with
  * larger segments will tend to be more efficient. Your slicer should have
  * options for G2/G3 arc generation. In future these options may be GCode tunable.
@@ -103,8 +125,17 @@ void plan_arc(
               mm_of_travel = linear_travel ? HYPOT(flat_mm, linear_travel) : ABS(flat_mm);
   if (mm_of_travel < 0.001f) return;
 
-  uint16_t segments = FLOOR(mm_of_travel / (MM_PER_ARC_SEGMENT));
+  const float fr_mm_s = MMS_SCALED(feedrate_mm_s);
+
+  #if ENABLED(ARC_CHORDAL_TOLERANCE)
+    const float seg_length = arc_segment_length(radius, fr_mm_s);
+  #else
+    constexpr float seg_length = MM_PER_ARC_SEGMENT;
+  #endif
+
+  uint16_t segments = FLOOR(mm_of_travel / seg_length);
   NOLESS(segments, min_segments);
+  const float mm_per_segment = mm_of_travel / segments;
 
   /**
    * Vector rotation by transformation matrix: r is the original vector, r_T is the rotated vector,
@@ -131,14 +162,22 @@ void plan_arc(
    * without the initial overhead of computing cos() or sin(). By the time the arc needs to be applied
    * a correction, the planner should have caught up to the lag caused by the initial plan_arc overhead.
    * This is important when there are successive arc motions.
+   *
+   * Adaptive segments can span a much larger angle on small radii, so the rotation
+   * matrix is computed exactly in that case. It is still only done once per arc.
    */
   // Vector rotation matrix values
   float raw[X_TO_E];
   const float theta_per_segment = angular_travel / segments,
               linear_per_segment = linear_travel / segments,
               extruder_per_segment = extruder_travel / segments,
-              sin_T = theta_per_segment,
-              cos_T = 1 - 0.5f * sq(theta_per_segment); // Small angle approximation
+              #if ENABLED(ARC_CHORDAL_TOLERANCE)
+                sin_T = sin(theta_per_segment),
+                cos_T = cos(theta_per_segment);
+              #else
+                sin_T = theta_per_segment,
+                cos_T = 1 - 0.5f * sq(theta_per_segment); // Small angle approximation
+              #endif
 
   // Initialize the linear axis
   raw[l_axis] = current_position[l_axis];
@@ -146,10 +185,8 @@ void plan_arc(
   // Initialize the extruder axis
   raw[E_AXIS] = current_position[E_AXIS];
 
-  const float fr_mm_s = MMS_SCALED(feedrate_mm_s);
-
   #if ENABLED(SCARA_FEEDRATE_SCALING)
-    const float inv_duration = fr_mm_s / MM_PER_ARC_SEGMENT;
+    const float inv_duration = fr_mm_s / mm_per_segment;
   #endif
 
   millis_t next_idle_ms = millis() + 200UL;
@@ -206,7 +243,7 @@ void plan_arc(
       planner.apply_leveling(raw);
     #endif
 
-    if (!planner.buffer_line(raw, fr_mm_s, active_extruder, MM_PER_ARC_SEGMENT
+    if (!planner.buffer_line(raw, fr_mm_s, active_extruder, mm_per_segment
       #if ENABLED(SCARA_FEEDRATE_SCALING)
         , inv_duration
       #endif
@@ -224,7 +261,7 @@ void plan_arc(
     planner.apply_leveling(raw);
   #endif
 
-  planner.buffer_line(raw, fr_mm_s, active_extruder, MM_PER_ARC_SEGMENT
+  planner.buffer_line(raw, fr_mm_s, active_extruder, mm_per_segment
     #if ENABLED(SCARA_FEEDRATE_SCALING)
       , inv_duration
     #endif
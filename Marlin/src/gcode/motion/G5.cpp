@@ -27,7 +27,7 @@
 #include "../../module/motion.h"
 #include "../../module/planner_bezier.h"
 
-void plan_cubic_move(const float (&cart)[XYZE], const float (&offset)[4]) {
+void plan_cubic_move(const float (&cart)[X_TO_E], const float (&offset)[4]) {
   cubic_b_spline(current_position, cart, offset, MMS_SCALED(feedrate_mm_s), active_extruder);
   COPY(current_position, cart);
 }
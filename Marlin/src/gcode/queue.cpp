@@ -41,6 +41,10 @@
   #include "../feature/power_loss_recovery.h"
 #endif
 
+#if ENABLED(MOVE_COALESCING)
+  #include "../module/move_coalescer.h"
+#endif
+
 /**
  * GCode line number handling. Hosts may opt to include line numbers when
  * sending commands to Marlin, and lines will be checked for sequentiality.
@@ -747,6 +751,10 @@ void get_available_commands() {
 void advance_command_queue() {
 
   if (!commands_in_queue) {
+    #if ENABLED(MOVE_COALESCING)
+      // Nothing more to merge with, keep the machine moving
+      coalescer.flush();
+    #endif
     vTaskDelay(pdMS_TO_TICKS(1));
     return;
   }
@@ -791,6 +791,84 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #endif
 #endif
 
+/**
+ * Leveling mesh slots hold the bilinear grid
+ */
+#if ENABLED(LEVELING_MESH_SLOTS)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR) || DISABLED(EEPROM_SETTINGS)
+    #error "LEVELING_MESH_SLOTS requires AUTO_BED_LEVELING_BILINEAR and EEPROM_SETTINGS."
+  #endif
+  static_assert(WITHIN(MESH_SLOT_NUM, 1, 8), "MESH_SLOT_NUM must be between 1 and 8.");
+#endif
+
+/**
+ * Quick probing must raise clear of the probe hysteresis
+ */
+#if ENABLED(QUICK_AUTO_PROBING)
+  static_assert(QUICK_PROBING_RECHECK >= Z_CLEARANCE_MULTI_PROBE, "QUICK_PROBING_RECHECK must be at least Z_CLEARANCE_MULTI_PROBE.");
+#endif
+
+/**
+ * Probe speed tuning keeps the speeds in EEPROM
+ */
+#if ENABLED(PROBE_SPEED_TUNING)
+  #if !HAS_BED_PROBE || DISABLED(EEPROM_SETTINGS)
+    #error "PROBE_SPEED_TUNING requires a bed probe and EEPROM_SETTINGS."
+  #endif
+  static_assert(WITHIN(PROBE_TUNING_SAMPLES, 2, 10), "PROBE_TUNING_SAMPLES must be between 2 and 10.");
+#endif
+
+/**
+ * Dual probe capture levels with quick probing
+ */
+#if ENABLED(DUAL_PROBE_CAPTURE) && (DISABLED(QUICK_AUTO_PROBING) || DISABLED(AUTO_BED_LEVELING_BILINEAR))
+  #error "DUAL_PROBE_CAPTURE requires QUICK_AUTO_PROBING and AUTO_BED_LEVELING_BILINEAR."
+#endif
+
+/**
+ * Bed thermal drift moves the bilinear mesh
+ */
+#if ENABLED(BED_THERMAL_DRIFT)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR) || DISABLED(EEPROM_SETTINGS)
+    #error "BED_THERMAL_DRIFT requires AUTO_BED_LEVELING_BILINEAR and EEPROM_SETTINGS."
+  #endif
+  static_assert(WITHIN(THERMAL_DRIFT_TEMPS, 2, 8), "THERMAL_DRIFT_TEMPS must be between 2 and 8.");
+#endif
+
+/**
+ * Incremental leveling updates the bilinear mesh
+ */
+#if ENABLED(INCREMENTAL_LEVELING)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "INCREMENTAL_LEVELING requires AUTO_BED_LEVELING_BILINEAR."
+  #endif
+  static_assert(WITHIN(INCREMENTAL_LEVELING_STEP, 1, GRID_MAX_NUM - 1), "INCREMENTAL_LEVELING_STEP must be between 1 and GRID_MAX_NUM - 1.");
+#endif
+
+/**
+ * Adaptive leveled segments follow the bilinear mesh
+ */
+#if ENABLED(LEVELED_SEGMENT_ADAPTIVE)
+  #if DISABLED(SEGMENT_LEVELED_MOVES) || DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "LEVELED_SEGMENT_ADAPTIVE requires SEGMENT_LEVELED_MOVES and AUTO_BED_LEVELING_BILINEAR."
+  #endif
+  static_assert(LEVELED_SEGMENT_MAX_LENGTH >= LEVELED_SEGMENT_LENGTH, "LEVELED_SEGMENT_MAX_LENGTH must not be less than LEVELED_SEGMENT_LENGTH.");
+#endif
+
+/**
+ * Job alignment keeps the camera calibration in EEPROM
+ */
+#if ENABLED(JOB_ALIGNMENT) && DISABLED(EEPROM_SETTINGS)
+  #error "JOB_ALIGNMENT requires EEPROM_SETTINGS."
+#endif
+
+/**
+ * Bicubic leveling cache is built with the subdivided grid
+ */
+#if ENABLED(ABL_BICUBIC_CACHE) && DISABLED(ABL_BILINEAR_SUBDIVISION)
+  #error "ABL_BICUBIC_CACHE requires ABL_BILINEAR_SUBDIVISION."
+#endif
+
 /**
  * Linear Advance 1.5 - Check K value range
  */
@@ -799,6 +877,10 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
     WITHIN(LIN_ADVANCE_K, 0, 10),
     "LIN_ADVANCE_K must be a value from 0 to 10 (Changed in LIN_ADVANCE v1.5, Marlin 1.1.9)."
   );
+  #if ENABLED(LIN_ADVANCE_UNIFIED)
+    static_assert(WITHIN(LIN_ADVANCE_STEPS_PER_ISR, 1, 32), "LIN_ADVANCE_STEPS_PER_ISR must be from 1 to 32.");
+    static_assert(LIN_ADVANCE_SMOOTH_TIME > 0, "LIN_ADVANCE_SMOOTH_TIME must be greater than 0.");
+  #endif
 #endif
 
 /**
@@ -915,6 +997,11 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
 #if BOTH(PIDTEMPBED, BED_LIMIT_SWITCHING)
   #error "To use BED_LIMIT_SWITCHING you must disable PIDTEMPBED."
 #endif
+#if BOTH(BED_SLOW_PWM, SLOW_PWM_HEATERS)
+  #error "BED_SLOW_PWM is not compatible with SLOW_PWM_HEATERS."
+#elif ENABLED(BED_SLOW_PWM) && BED_PWM_MIN_STATE * 2 >= BED_PWM_PERIOD
+  #error "BED_PWM_MIN_STATE must be less than half of BED_PWM_PERIOD."
+#endif
 
 /**
  * Kinematics
@@ -37,7 +37,7 @@
  */
 
 // Change EEPROM version if the structure changes
-#define EEPROM_VERSION "V77"
+#define EEPROM_VERSION "V83"
 #define EEPROM_OFFSET 100
 
 // Check the integrity of data offsets.
@@ -61,6 +61,11 @@
   #include "../module/ft_motion.h"
 #endif
 #include "../../../snapmaker/src/module/enclosure.h"
+#include "../../../snapmaker/src/service/nozzle_profile.h"
+#include "../../../snapmaker/src/service/mesh_slot.h"
+#include "../../../snapmaker/src/service/thermal_drift.h"
+#include "../../../snapmaker/src/service/job_align.h"
+#include "../../../snapmaker/src/service/hotend_feedforward.h"
 
 #if EITHER(EEPROM_SETTINGS, SD_FIRMWARE_UPDATE)
   #include "../HAL/shared/persistent_store_api.h"
@@ -335,10 +340,58 @@ typedef struct SettingsDataStruct {
     ft_config_t ftMotion_cfg;                          // M493
   #endif
 
+  //
+  // Nozzle motion profiles
+  //
+  #if ENABLED(NOZZLE_MOTION_PROFILE)
+    nozzle_profile_t nozzle_profiles[HOTEND_INFO_MAX]; // M1034
+  #endif
+
+  //
+  // Leveling mesh slots
+  //
+  #if ENABLED(LEVELING_MESH_SLOTS)
+    mesh_slot_t mesh_slots[MESH_SLOT_NUM];              // M1035
+    uint8_t mesh_slot_bed, mesh_slot_active;
+  #endif
+
+  //
+  // Bed thermal drift
+  //
+  #if ENABLED(BED_THERMAL_DRIFT)
+    thermal_drift_t thermal_drift_cfg;                  // M1036
+  #endif
+
+  //
+  // Probe speed tuning
+  //
+  #if ENABLED(PROBE_SPEED_TUNING)
+    float z_probe_speed_fast, z_probe_speed_slow;      // M1037
+  #endif
+
+  //
+  // Job alignment
+  //
+  #if ENABLED(JOB_ALIGNMENT)
+    job_align_cfg_t job_align_cfg;                      // M1039
+  #endif
+
+  //
+  // Hotend feed-forward
+  //
+  #if ENABLED(HOTEND_FEEDFORWARD)
+    HotendModel_t hotend_ff_model[EXTRUDERS];           // M306
+  #endif
+
   // enclosure door checking
   bool enclosure_door_check;
 } SettingsData;
 
+#if ENABLED(EEPROM_SETTINGS)
+  // The flash store works on a 4K copy of the EEPROM pages and doesn't check the bounds
+  static_assert(EEPROM_OFFSET + sizeof(SettingsData) <= 4096, "SettingsData doesn't fit in the 4K EEPROM.");
+#endif
+
 MarlinSettings settings;
 
 uint16_t MarlinSettings::datasize() { return sizeof(SettingsData); }
@@ -1199,6 +1252,59 @@ void MarlinSettings::postprocess() {
       EEPROM_WRITE(ftMotion.cfg);
     #endif
 
+    //
+    // Nozzle motion profiles
+    //
+    #if ENABLED(NOZZLE_MOTION_PROFILE)
+      _FIELD_TEST(nozzle_profiles);
+      EEPROM_WRITE(nozzle_profile.profile);
+    #endif
+
+    //
+    // Leveling mesh slots
+    //
+    #if ENABLED(LEVELING_MESH_SLOTS)
+      mesh_slot.Capture();
+      _FIELD_TEST(mesh_slots);
+      EEPROM_WRITE(mesh_slot.slot);
+      EEPROM_WRITE(mesh_slot.bed_);
+      EEPROM_WRITE(mesh_slot.active_);
+    #endif
+
+    //
+    // Bed thermal drift
+    //
+    #if ENABLED(BED_THERMAL_DRIFT)
+      thermal_drift.Capture();
+      _FIELD_TEST(thermal_drift_cfg);
+      EEPROM_WRITE(thermal_drift.cfg);
+    #endif
+
+    //
+    // Probe speed tuning
+    //
+    #if ENABLED(PROBE_SPEED_TUNING)
+      _FIELD_TEST(z_probe_speed_fast);
+      EEPROM_WRITE(z_probe_speed_fast);
+      EEPROM_WRITE(z_probe_speed_slow);
+    #endif
+
+    //
+    // Job alignment
+    //
+    #if ENABLED(JOB_ALIGNMENT)
+      _FIELD_TEST(job_align_cfg);
+      EEPROM_WRITE(job_align.cfg);
+    #endif
+
+    //
+    // Hotend feed-forward
+    //
+    #if ENABLED(HOTEND_FEEDFORWARD)
+      _FIELD_TEST(hotend_ff_model);
+      EEPROM_WRITE(hotend_ff.model);
+    #endif
+
     // enclosure door checking
     EEPROM_WRITE(enclosure.enabled_);
 
@@ -1985,6 +2091,58 @@ void MarlinSettings::postprocess() {
         EEPROM_READ(ftMotion.cfg);
       #endif
 
+      //
+      // Nozzle motion profiles
+      //
+      #if ENABLED(NOZZLE_MOTION_PROFILE)
+        _FIELD_TEST(nozzle_profiles);
+        EEPROM_READ(nozzle_profile.profile);
+      #endif
+
+      //
+      // Leveling mesh slots
+      //
+      #if ENABLED(LEVELING_MESH_SLOTS)
+        _FIELD_TEST(mesh_slots);
+        EEPROM_READ(mesh_slot.slot);
+        EEPROM_READ(mesh_slot.bed_);
+        EEPROM_READ(mesh_slot.active_);
+      #endif
+
+      //
+      // Bed thermal drift
+      //
+      #if ENABLED(BED_THERMAL_DRIFT)
+        _FIELD_TEST(thermal_drift_cfg);
+        EEPROM_READ(thermal_drift.cfg);
+        if (!validating) thermal_drift.Fit();
+      #endif
+
+      //
+      // Probe speed tuning
+      //
+      #if ENABLED(PROBE_SPEED_TUNING)
+        _FIELD_TEST(z_probe_speed_fast);
+        EEPROM_READ(z_probe_speed_fast);
+        EEPROM_READ(z_probe_speed_slow);
+      #endif
+
+      //
+      // Job alignment
+      //
+      #if ENABLED(JOB_ALIGNMENT)
+        _FIELD_TEST(job_align_cfg);
+        EEPROM_READ(job_align.cfg);
+      #endif
+
+      //
+      // Hotend feed-forward
+      //
+      #if ENABLED(HOTEND_FEEDFORWARD)
+        _FIELD_TEST(hotend_ff_model);
+        EEPROM_READ(hotend_ff.model);
+      #endif
+
       // enclosure door checking
       EEPROM_READ(enclosure.enabled_);
 
@@ -2621,6 +2779,39 @@ void MarlinSettings::reset() {
   //
   TERN_(FT_MOTION, ftMotion.set_defaults());
 
+  //
+  // Nozzle motion profiles
+  //
+  TERN_(NOZZLE_MOTION_PROFILE, nozzle_profile.Reset());
+
+  //
+  // Leveling mesh slots
+  //
+  TERN_(LEVELING_MESH_SLOTS, mesh_slot.Reset());
+
+  //
+  // Bed thermal drift
+  //
+  TERN_(BED_THERMAL_DRIFT, thermal_drift.Reset());
+
+  //
+  // Probe speed tuning
+  //
+  #if ENABLED(PROBE_SPEED_TUNING)
+    z_probe_speed_fast = Z_PROBE_SPEED_FAST;
+    z_probe_speed_slow = Z_PROBE_SPEED_SLOW;
+  #endif
+
+  //
+  // Job alignment
+  //
+  TERN_(JOB_ALIGNMENT, job_align.Reset());
+
+  //
+  // Hotend feed-forward
+  //
+  TERN_(HOTEND_FEEDFORWARD, hotend_ff.Reset());
+
   // enclosure door checking
   enclosure.enabled_ = ENCLOSURE_DOOR_CHECK_DEFAULT;
 
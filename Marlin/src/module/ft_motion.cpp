@@ -130,6 +130,10 @@ uint32_t FTMotion::interpIdx = 0,               // Index of current data point b
   // Linear advance variables.
   float FTMotion::e_raw_z1 = 0.0f;        // (ms) Unit delay of raw extruder position.
   float FTMotion::e_advanced_z1 = 0.0f;   // (ms) Unit delay of advanced extruder position.
+  #if ENABLED(LIN_ADVANCE_UNIFIED)
+    float FTMotion::e_adv_rate_z1 = 0.0f;
+    float FTMotion::blockAdvK = 0.0f;
+  #endif
 #endif
 
 constexpr uint32_t last_batchIdx = (FTM_WINDOW_SIZE) - (FTM_BATCH_SIZE);
@@ -195,7 +199,8 @@ void FTMotion::addSyncCommandBlockInfo(block_t *blk) {
     return;
   }
 
-  blockInfoSyncBuff[blockInfoSyncBuffIndex].new_block_file_position = blk->filePos;
+  // the line is taken when the block starts, so a resend has to run all of a coalesced run
+  blockInfoSyncBuff[blockInfoSyncBuffIndex].new_block_file_position = TERN(MOVE_COALESCING, blk->filePosFirst, blk->filePos);
   blockInfoSyncBuff[blockInfoSyncBuffIndex].new_block_steps_x = blk->steps[X_AXIS];
   blockInfoSyncBuff[blockInfoSyncBuffIndex].new_block_steps_y = blk->steps[Y_AXIS];
   blockInfoSyncBuff[blockInfoSyncBuffIndex].new_block_steps_e = blk->steps[E_AXIS] 
@@ -546,6 +551,7 @@ void FTMotion::reset() {
     shaping.zi_idx = 0;
   #endif
   TERN_(HAS_EXTRUDERS, e_raw_z1 = e_advanced_z1 = 0.0f);
+  TERN_(LIN_ADVANCE_UNIFIED, e_adv_rate_z1 = blockAdvK = 0.0f);
 
   memset(&ftMotion.ft_current_block, 0, sizeof(ftMotion.ft_current_block));
   memset(blockInfoSyncBuff, 0, sizeof(blockInfoSyncBuff));
@@ -626,6 +632,13 @@ void FTMotion::loadBlockData(block_t * const current_block) {
 
   ratio = moveDist * oneOverLength; // 算出各轴移动距离，与合成运动距离的比值，耦合方向，有正负号
 
+  #if ENABLED(LIN_ADVANCE_UNIFIED)
+    // M900 K is per E speed, the trajectory gain is per path speed.
+    // Keep the last gain over travel and retract moves, the stepper path keeps the pressure too.
+    if (current_block->use_advance_lead)
+      blockAdvK = planner.extruder_advance_K[current_block->extruder] * ratio.e;
+  #endif
+
   const float spm = totalLength / current_block->step_event_count;  // (steps/mm) Distance for each step 每步移动的距离，step_event_count是最长轴的步数
 
   f_s = spm * current_block->initial_rate;              // (steps/s) Start feedrate 每步移动的距离，乘以1s发出的步数，那就是1s移动的距离，所以得到速度，initial_rate是初始的step rate
@@ -755,7 +768,15 @@ void FTMotion::makeVector() {
   #if HAS_EXTRUDERS
     if (cfg.linearAdvEna) {
       float dedt_adj = (traj.e[makeVector_batchIdx] - e_raw_z1) * (FTM_FS);
-      if (ratio.e > 0.0f) dedt_adj += accel_k * cfg.linearAdvK;
+      #if ENABLED(LIN_ADVANCE_UNIFIED)
+        // Same filter as the stepper path, so the advance has no step change at phase boundaries
+        constexpr float adv_alpha = (FTM_TS) / ((LIN_ADVANCE_SMOOTH_TIME) + (FTM_TS));
+        const float adv_rate = ratio.e > 0.0f ? accel_k * blockAdvK : 0.0f;
+        e_adv_rate_z1 += (adv_rate - e_adv_rate_z1) * adv_alpha;
+        dedt_adj += e_adv_rate_z1;
+      #else
+        if (ratio.e > 0.0f) dedt_adj += accel_k * cfg.linearAdvK;
+      #endif
 
       e_raw_z1 = traj.e[makeVector_batchIdx];
       e_advanced_z1 += dedt_adj * (FTM_TS);
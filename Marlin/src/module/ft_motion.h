@@ -221,6 +221,10 @@ class FTMotion {
     // Linear advance variables.
     #if HAS_EXTRUDERS
       static float e_raw_z1, e_advanced_z1;
+      #if ENABLED(LIN_ADVANCE_UNIFIED)
+        static float e_adv_rate_z1, // (mm/s) Unit delay of smoothed advance rate
+                     blockAdvK;     // Gain of the current block, from M900 K
+      #endif
     #endif
 
     // Private methods
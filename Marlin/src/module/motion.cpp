@@ -861,6 +861,122 @@ void clean_up_after_endstop_or_probe_move() {
       );
     }
 
+  #if ENABLED(LEVELED_SEGMENT_ADAPTIVE)
+
+    // Leveling Z where the planner takes it: at the machine XY the job XY is aligned and skewed to
+    FORCE_INLINE static float leveled_z_offset(float (&p)[XYZ]) {
+      #if ENABLED(JOB_ALIGNMENT)
+        planner.align(p);
+        planner.align_limit(p);
+      #endif
+      #if ENABLED(SKEW_CORRECTION)
+        planner.skew(p);
+      #endif
+      return bilinear_z_offset(p);
+    }
+
+    /**
+     * Check the leveling Z along the move from t0 to t1 against the straight
+     * line between its ends, since the planner levels only the ends of each
+     * block. Sample no farther apart than LEVELED_SEGMENT_LENGTH so a bump
+     * the fixed segments would have followed is not skipped.
+     */
+    static bool leveled_segment_is_straight(const float (&from)[X_TO_E], const float (&diff)[X_TO_E],
+                                            const float t0, const float t1, const float cartesian_mm) {
+      float p[XYZ];
+
+      #define LEVELED_Z_AT(T) do{ LOOP_XYZ(a) p[a] = from[a] + diff[a] * (T); }while(0)
+
+      LEVELED_Z_AT(t0);
+      const float z0 = leveled_z_offset(p);
+      LEVELED_Z_AT(t1);
+      const float z1 = leveled_z_offset(p);
+
+      const uint16_t samples = MAX(2.0f, CEIL(cartesian_mm * (t1 - t0) / (LEVELED_SEGMENT_LENGTH)));
+      const float inv_samples = 1.0f / samples;
+
+      for (uint16_t i = 1; i < samples; i++) {
+        const float f = i * inv_samples;
+        LEVELED_Z_AT(t0 + (t1 - t0) * f);
+        if (ABS(leveled_z_offset(p) - (z0 + (z1 - z0) * f)) > LEVELED_SEGMENT_TOLERANCE)
+          return false;
+      }
+
+      #undef LEVELED_Z_AT
+
+      return true;
+    }
+
+    /**
+     * Prepare a segmented move on a CARTESIAN setup, splitting only
+     * where the mesh is not straight along the move.
+     */
+    inline void adaptive_line_to_destination(const float &fr_mm_s) {
+
+      const float xdiff = destination[X_AXIS] - current_position[X_AXIS],
+                  ydiff = destination[Y_AXIS] - current_position[Y_AXIS];
+
+      // If the move is only in Z/E don't split up the move
+      if (!xdiff && !ydiff) {
+        planner.buffer_line(destination, fr_mm_s, active_extruder);
+        return;
+      }
+
+      float from[X_TO_E], diff[X_TO_E];
+      COPY(from, current_position);
+      LOOP_X_TO_E(i) diff[i] = destination[i] - current_position[i];
+
+      float cartesian_mm = SQRT(sq(diff[X_AXIS]) + sq(diff[Y_AXIS]) + sq(diff[Z_AXIS]) + sq(diff[B_AXIS]));
+      if (UNEAR_ZERO(cartesian_mm)) cartesian_mm = ABS(diff[E_AXIS]);
+      if (UNEAR_ZERO(cartesian_mm)) return;
+
+      // Segment lengths as fractions of the move
+      const float inv_mm = 1.0f / cartesian_mm,
+                  min_t = LEVELED_SEGMENT_LENGTH * inv_mm,
+                  max_t = LEVELED_SEGMENT_MAX_LENGTH * inv_mm;
+
+      float raw[X_TO_E];
+      float t0 = 0;
+
+      while (t0 < 1.0f) {
+        float t1 = MIN(t0 + max_t, 1.0f);
+
+        // Halve until straight, but not under the fixed segment length
+        while (t1 - t0 > min_t && !leveled_segment_is_straight(from, diff, t0, t1, cartesian_mm)) {
+          const float half = t0 + (t1 - t0) * 0.5f;
+          if (half <= t0 + min_t) {
+            t1 = t0 + min_t;
+            break;
+          }
+          t1 = half;
+        }
+
+        // Don't leave a tail shorter than half a segment, if the merged piece is still straight
+        if (t1 < 1.0f && 1.0f - t1 < min_t * 0.5f && leveled_segment_is_straight(from, diff, t0, 1.0f, cartesian_mm))
+          t1 = 1.0f;
+
+        if (t1 >= 1.0f) break;
+
+        static millis_t next_idle_ms = millis() + 200UL;
+        thermalManager.manage_heater();  // This returns immediately if not really needed.
+        if (ELAPSED(millis(), next_idle_ms)) {
+          next_idle_ms = millis() + 200UL;
+          idle();
+        }
+
+        LOOP_X_TO_E(i) raw[i] = from[i] + diff[i] * t1;
+        if (!planner.buffer_line(raw, fr_mm_s, active_extruder, cartesian_mm * (t1 - t0)))
+          return;
+
+        t0 = t1;
+      }
+
+      // The final move must be to the exact destination
+      planner.buffer_line(destination, fr_mm_s, active_extruder, cartesian_mm * (1.0f - t0));
+    }
+
+  #endif // LEVELED_SEGMENT_ADAPTIVE
+
   #endif // SEGMENT_LEVELED_MOVES
 
   /**
@@ -877,6 +993,9 @@ void clean_up_after_endstop_or_probe_move() {
         #if ENABLED(AUTO_BED_LEVELING_UBL)
           ubl.line_to_destination_cartesian(MMS_SCALED(feedrate_mm_s), active_extruder);  // UBL's motion routine needs to know about
           return true;                                                                    // all moves, including Z-only moves.
+        #elif ENABLED(LEVELED_SEGMENT_ADAPTIVE)
+          adaptive_line_to_destination(MMS_SCALED(feedrate_mm_s));
+          return false; // caller will update current_position
         #elif ENABLED(SEGMENT_LEVELED_MOVES)
           segmented_line_to_destination(MMS_SCALED(feedrate_mm_s));
           return false; // caller will update current_position
@@ -0,0 +1,164 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * move_coalescer.cpp
+ *
+ * Merge runs of collinear G0/G1 moves before planning
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(MOVE_COALESCING)
+
+#include "move_coalescer.h"
+#include "motion.h"
+#include "../gcode/queue.h"
+
+MoveCoalescer coalescer;
+
+bool MoveCoalescer::enabled = true;
+float MoveCoalescer::chordal_tolerance = MOVE_COALESCE_CHORDAL_TOLERANCE,
+      MoveCoalescer::cos_angular_tolerance = cos(RADIANS(MOVE_COALESCE_ANGULAR_TOLERANCE));
+
+bool MoveCoalescer::pending; // = false
+float MoveCoalescer::start[X_TO_E],
+      MoveCoalescer::end[X_TO_E],
+      MoveCoalescer::dir[XYZ],
+      MoveCoalescer::run_mm,
+      MoveCoalescer::e_per_mm,
+      MoveCoalescer::feedrate;
+uint8_t MoveCoalescer::extruder;
+uint32_t MoveCoalescer::file_pos,
+         MoveCoalescer::first_file_pos;
+laser_state_t MoveCoalescer::laser;
+uint32_t MoveCoalescer::merged; // = 0
+
+// Compare field by field, the bit-fields and padding rule out memcmp
+static inline bool same_laser_state(const laser_state_t &a, const laser_state_t &b) {
+  return a.status.isEnabled == b.status.isEnabled
+      && a.status.trapezoid_power == b.status.trapezoid_power
+      && a.status.is_sync_power == b.status.is_sync_power
+      && a.status.power_is_map == b.status.power_is_map
+      && a.power == b.power
+      && a.sync_power == b.sync_power;
+}
+
+// Line of the command being executed, recorded in the block of the run
+static inline uint32_t current_line() {
+  return commands_in_queue ? CommandLine[cmd_queue_index_r] : INVALID_CMD_LINE;
+}
+
+void MoveCoalescer::begin(const float (&from)[X_TO_E], const float (&to)[X_TO_E], const float (&delta)[XYZ], const float mm) {
+  COPY(start, from);
+  COPY(end, to);
+  const float inv_mm = 1.0f / mm;
+  LOOP_XYZ(i) dir[i] = delta[i] * inv_mm;
+  run_mm = mm;
+  e_per_mm = (to[E_AXIS] - from[E_AXIS]) * inv_mm;
+  feedrate = feedrate_mm_s;
+  extruder = active_extruder;
+  laser = planner.laser_inline;
+  file_pos = first_file_pos = current_line();
+  pending = true;
+}
+
+bool MoveCoalescer::can_extend(const float (&to)[X_TO_E], const float (&delta)[XYZ], const float mm) {
+  if (feedrate != feedrate_mm_s || extruder != active_extruder) return false;
+  if (!same_laser_state(laser, planner.laser_inline)) return false;
+  if (run_mm + mm > (MOVE_COALESCE_MAX_LENGTH)) return false;
+
+  // The segment must point the same way as the run...
+  if (delta[X_AXIS] * dir[X_AXIS] + delta[Y_AXIS] * dir[Y_AXIS] + delta[Z_AXIS] * dir[Z_AXIS] < cos_angular_tolerance * mm)
+    return false;
+
+  // ...and end close enough to the line the run started on
+  float rel[XYZ];
+  LOOP_XYZ(i) rel[i] = to[i] - start[i];
+  const float along = rel[X_AXIS] * dir[X_AXIS] + rel[Y_AXIS] * dir[Y_AXIS] + rel[Z_AXIS] * dir[Z_AXIS],
+              perp_sq = sq(rel[X_AXIS]) + sq(rel[Y_AXIS]) + sq(rel[Z_AXIS]) - sq(along);
+  if (perp_sq > sq(chordal_tolerance)) return false;
+
+  // Keep the extrusion width, within 1%
+  const float seg_e_per_mm = (to[E_AXIS] - end[E_AXIS]) / mm;
+  if (ABS(seg_e_per_mm - e_per_mm) > ABS(e_per_mm) * 0.01f + 0.000001f) return false;
+
+  return true;
+}
+
+bool MoveCoalescer::add() {
+  if (!enabled) {
+    flush();
+    return false;
+  }
+
+  float delta[XYZ];
+  LOOP_XYZ(i) delta[i] = destination[i] - current_position[i];
+  const float mm = SQRT(sq(delta[X_AXIS]) + sq(delta[Y_AXIS]) + sq(delta[Z_AXIS]));
+
+  // E-only and rotary moves go to the planner as they are
+  if (mm < 0.0001f || destination[B_AXIS] != current_position[B_AXIS]) {
+    flush();
+    return false;
+  }
+
+  if (pending && can_extend(destination, delta, mm)) {
+    COPY(end, destination);
+    run_mm += mm;
+    file_pos = current_line();
+    merged++;
+  }
+  else {
+    flush();
+    begin(current_position, destination, delta, mm);
+  }
+
+  set_current_from_destination();
+  return true;
+}
+
+void MoveCoalescer::flush() {
+  if (!pending) return;
+  pending = false;
+
+  // Replay the run with the state it was given with
+  float saved_destination[X_TO_E];
+  COPY(saved_destination, destination);
+  const float saved_feedrate = feedrate_mm_s;
+  const laser_state_t saved_laser = planner.laser_inline;
+
+  COPY(current_position, start);
+  COPY(destination, end);
+  feedrate_mm_s = feedrate;
+  planner.laser_inline = laser;
+  planner.file_pos_override = file_pos;
+  planner.file_pos_first_override = first_file_pos;
+
+  prepare_move_to_destination();
+
+  planner.file_pos_override = planner.file_pos_first_override = INVALID_CMD_LINE;
+  planner.laser_inline = saved_laser;
+  feedrate_mm_s = saved_feedrate;
+  COPY(destination, saved_destination);
+}
+
+#endif // MOVE_COALESCING
@@ -0,0 +1,91 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * move_coalescer.h
+ *
+ * Merge runs of collinear G0/G1 moves into a single move before they
+ * reach the planner. Laser rasters and finely sliced models produce long
+ * runs of tiny segments on the same line; each of them costs a planner
+ * block and a full lookahead pass.
+ *
+ * The run in progress is held back from the planner while current_position
+ * already points to its end, so any command other than G0/G1 must call
+ * flush() before it looks at the planner. A run is only extended when the
+ * feedrate, extruder, extrusion ratio and inline laser power are unchanged,
+ * so per-segment laser power changes are preserved.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(MOVE_COALESCING)
+
+#include "planner.h"
+
+class MoveCoalescer {
+  public:
+    static bool enabled;
+    static float chordal_tolerance,   // (mm) Max distance of a merged point from the run direction
+                 cos_angular_tolerance; // Cosine of the max angle between a segment and the run direction
+
+    static void set_angular_tolerance(const float deg) { cos_angular_tolerance = cos(RADIANS(deg)); }
+    static float angular_tolerance() { return DEGREES(acos(cos_angular_tolerance)); }
+
+    /**
+     * Take the move from current_position to destination.
+     * Returns true if the move is now held by the coalescer, with
+     * current_position set to destination, or false if the caller
+     * has to send it to the planner itself.
+     */
+    static bool add();
+
+    // Send the held run to the planner
+    static void flush();
+
+    // Forget the held run, e.g. when current_position was reloaded from the steppers
+    static void discard() { pending = false; }
+
+    static bool has_pending() { return pending; }
+    static uint32_t merged_count() { return merged; }
+
+  private:
+    static bool pending;
+    static float start[X_TO_E],       // Where the planner is, i.e. the start of the run
+                 end[X_TO_E],         // Logical end of the run
+                 dir[XYZ],            // Unit vector of the first segment of the run
+                 run_mm,              // XYZ length of the run
+                 e_per_mm,            // Extrusion ratio of the run
+                 feedrate;            // feedrate_mm_s of the run
+    static uint8_t extruder;
+    static uint32_t file_pos,         // Line of the last command in the run, where a resume goes on from
+                    first_file_pos;   // Line of the first command in the run, where a resend starts from
+    static laser_state_t laser;       // Inline laser state of the run
+    static uint32_t merged;           // Statistics: segments merged since boot
+
+    static void begin(const float (&from)[X_TO_E], const float (&to)[X_TO_E], const float (&delta)[XYZ], const float mm);
+    static bool can_extend(const float (&to)[X_TO_E], const float (&delta)[XYZ], const float mm);
+};
+
+extern MoveCoalescer coalescer;
+
+#endif // MOVE_COALESCING
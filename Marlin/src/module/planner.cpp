@@ -73,6 +73,7 @@
 
 #include "../../../snapmaker/src/snapmaker.h"
 #include "../../../snapmaker/src/module/toolhead_laser.h"
+#include "../../../snapmaker/src/service/laser_raster.h"
 
 #if ENABLED(FT_MOTION)
   #include "ft_motion.h"
@@ -122,6 +123,15 @@ planner_settings_t Planner::settings;           // Initialized by settings.load(
 
 laser_state_t Planner::laser_inline = {0};            // Planner laser power for blocks
 
+#if ENABLED(MOVE_COALESCING)
+  uint32_t Planner::file_pos_override = INVALID_CMD_LINE,
+           Planner::file_pos_first_override = INVALID_CMD_LINE;
+#endif
+
+#if ENABLED(LASER_RASTER_MODE)
+  uint8_t Planner::raster_slot = LASER_RASTER_SLOT_NONE;
+#endif
+
 uint32_t Planner::max_acceleration_steps_per_s2[X_TO_EN]; // (steps/s^2) Derived from mm_per_s2
 
 float Planner::steps_to_mm[X_TO_EN];           // (mm) Millimeters per step
@@ -162,6 +172,11 @@ float Planner::e_factor[EXTRUDERS] = ARRAY_BY_EXTRUDERS1(1.0f); // The flow perc
         Planner::volumetric_multiplier[EXTRUDERS];  // Reciprocal of cross-sectional area of filament (in mm^2). Pre-calculated to reduce computation in the planner
 #endif
 
+#if ENABLED(VOLUMETRIC_FLOW_LIMIT)
+  float Planner::volumetric_extruder_limit[EXTRUDERS],          // (mm³/s) Max melt rate of each hotend, 0 for no limit
+        Planner::volumetric_extruder_feedrate_limit[EXTRUDERS]; // (mm/s) Same limit as filament speed
+#endif
+
 #if HAS_LEVELING
   bool Planner::leveling_active = false; // Flag that auto bed leveling is enabled
   #if ABL_PLANAR
@@ -177,6 +192,10 @@ float Planner::e_factor[EXTRUDERS] = ARRAY_BY_EXTRUDERS1(1.0f); // The flow perc
 #endif
 
 skew_factor_t Planner::skew_factor; // Initialized by settings.load()
+
+#if ENABLED(JOB_ALIGNMENT)
+  job_transform_t Planner::job_transform; // Set by M1040
+#endif
 float Planner::min_planner_speed;
 #if ENABLED(AUTOTEMP)
   float Planner::autotemp_max = 250,
@@ -217,7 +236,7 @@ float Planner::previous_speed[NUM_AXIS],
   float Planner::position_cart[XYZE];
 #endif
 
-#if ENABLED(ULTRA_LCD)
+#if EITHER(ULTRA_LCD, IDLE_NOZZLE_PREHEAT)
   volatile uint32_t Planner::block_buffer_runtime_us = 0;
 #endif
 
@@ -787,6 +806,28 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
       block->laser.power_exit = laser->get_inline_pwm_power_floor();
     }
   }
+
+  if (block->laser.status.trapezoid_power) {
+    const bool offset_ramp = laser->device_id() == MODULE_DEVICE_ID_LASER_RED_2W_2023;
+    set_laser_ramp(block->laser_ramp.accel_base, block->laser_ramp.accel_factor, block->laser.power, block->laser.power_entry, block->nominal_rate, offset_ramp);
+    set_laser_ramp(block->laser_ramp.decel_base, block->laser_ramp.decel_factor, block->laser.power, block->laser.power_exit, block->nominal_rate, offset_ramp);
+  }
+}
+
+/**
+ * Set up the line the stepper ISR follows for laser power versus step rate
+ * during one ramp of the trapezoid. Power is proportional to the step rate,
+ * reaching the nominal power at the nominal rate. The red 2W laser instead
+ * ramps from the entry/exit power, as it does not fire below a power floor.
+ */
+void Planner::set_laser_ramp(uint16_t &base, uint32_t &factor, const uint16_t power, const uint16_t end_power, const uint32_t nominal_rate, const bool offset_ramp) {
+  uint16_t span = power;
+  base = 0;
+  if (offset_ramp) {
+    base = power > end_power ? end_power : power;
+    span = power > end_power ? power - end_power : power;
+  }
+  factor = (uint32_t(span) << 16) / nominal_rate;
 }
 
 /*                            PLANNER SPEED DEFINITION
@@ -1517,7 +1558,7 @@ void Planner::quick_stop() {
   // forced to empty, there's no risk the ISR will touch this.
   delay_before_delivering = TERN_(FT_MOTION, ftMotion.cfg.mode ? BLOCK_DELAY_NONE :) BLOCK_DELAY_FOR_1ST_MOVE;
 
-  #if ENABLED(ULTRA_LCD)
+  #if EITHER(ULTRA_LCD, IDLE_NOZZLE_PREHEAT)
     // Clear the accumulated runtime
     clear_block_buffer_runtime();
   #endif
@@ -1730,6 +1771,16 @@ bool Planner::_buffer_steps(const int32_t (&target)[X_TO_E]
   else
     block->filePos = INVALID_CMD_LINE;
 
+  #if ENABLED(MOVE_COALESCING)
+    // A coalesced run records its last line, where a resume goes on from,
+    // and its first line, where resending the run starts from
+    block->filePosFirst = block->filePos;
+    if (file_pos_override != INVALID_CMD_LINE) {
+      block->filePos = file_pos_override;
+      block->filePosFirst = file_pos_first_override;
+    }
+  #endif
+
   // If this is the first added movement, reload the delay, otherwise, cancel it.
   if (block_buffer_head == block_buffer_tail) {
     // If it was the first queued block, restart the 1st block delivery delay, to
@@ -1865,6 +1916,12 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   block->laser.power = laser_inline.status.isEnabled ? laser_inline.power : 0;
   block->laser.sync_power = laser_inline.sync_power;
 
+  #if ENABLED(LASER_RASTER_MODE)
+    // The stepper ISR drives the laser from the raster slot instead
+    block->raster_slot = raster_slot;
+    if (raster_slot != LASER_RASTER_SLOT_NONE) block->laser.status.isEnabled = false;
+  #endif
+
   // Set direction bits
   block->direction_bits = dm;
 
@@ -2164,7 +2221,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   const uint8_t moves_queued = nonbusy_movesplanned();
 
   // Slow down when the buffer starts to empty, rather than wait at the corner for a buffer refill
-  #if EITHER(SLOWDOWN, ULTRA_LCD) || defined(XY_FREQUENCY_LIMIT)
+  #if ANY(SLOWDOWN, ULTRA_LCD, IDLE_NOZZLE_PREHEAT) || defined(XY_FREQUENCY_LIMIT)
     // Segment time im micro seconds
     uint32_t segment_time_us = LROUND(1000000.0f / inverse_secs);
   #endif
@@ -2175,19 +2232,20 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
         // buffer is draining, add extra time.  The amount of time added increases if the buffer is still emptied more.
         const uint32_t nst = segment_time_us + LROUND(2 * (settings.min_segment_time_us - segment_time_us) / moves_queued);
         inverse_secs = 1000000.0f / nst;
-        #if defined(XY_FREQUENCY_LIMIT) || ENABLED(ULTRA_LCD)
+        #if defined(XY_FREQUENCY_LIMIT) || EITHER(ULTRA_LCD, IDLE_NOZZLE_PREHEAT)
           segment_time_us = nst;
         #endif
       }
     }
   #endif
 
-  #if ENABLED(ULTRA_LCD)
+  #if EITHER(ULTRA_LCD, IDLE_NOZZLE_PREHEAT)
     // Protect the access to the position.
     const bool was_enabled = STEPPER_ISR_ENABLED();
     if (was_enabled) DISABLE_STEPPER_DRIVER_INTERRUPT();
 
     block_buffer_runtime_us += segment_time_us;
+    block->segment_time_us = segment_time_us;
 
     if (was_enabled) ENABLE_STEPPER_DRIVER_INTERRUPT();
   #endif
@@ -2262,6 +2320,14 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     if (cs > settings.max_feedrate_mm_s[i]) NOMORE(speed_factor, settings.max_feedrate_mm_s[i] / cs);
   }
 
+  #if ENABLED(VOLUMETRIC_FLOW_LIMIT)
+    // Only extrusion along a move has to be molten on the way
+    if (current_speed[E_AXIS] > 0 && (block->steps[X_AXIS] || block->steps[Y_AXIS] || block->steps[Z_AXIS])) {
+      const float max_e = volumetric_extruder_feedrate_limit[extruder];
+      if (max_e > 0 && current_speed[E_AXIS] > max_e) NOMORE(speed_factor, max_e / current_speed[E_AXIS]);
+    }
+  #endif
+
   // Max segment time in µs.
   #ifdef XY_FREQUENCY_LIMIT
 
@@ -2424,6 +2490,10 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
         if (block->advance_speed < 200)
           SERIAL_ECHOLNPGM("eISR running at > 10kHz.");
       #endif
+      #if ENABLED(LIN_ADVANCE_UNIFIED)
+        // K * E speed in steps, E speed = step_event rate * esteps / step_event_count
+        block->advance_scale = extruder_advance_K[active_extruder] * esteps / block->step_event_count * 65536.0f;
+      #endif
     }
   #endif
 
@@ -3170,7 +3240,7 @@ block_t* Planner::get_current_block() {
     // No trapezoid calculated? Don't execute yet.
     if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return NULL;
 
-    #if ENABLED(ULTRA_LCD)
+    #if EITHER(ULTRA_LCD, IDLE_NOZZLE_PREHEAT)
       block_buffer_runtime_us -= block->segment_time_us; // We can't be sure how long an active block will take, so don't count it.
     #endif
 
@@ -3186,7 +3256,7 @@ block_t* Planner::get_current_block() {
   }
 
   // The queue became empty
-  #if ENABLED(ULTRA_LCD)
+  #if EITHER(ULTRA_LCD, IDLE_NOZZLE_PREHEAT)
     clear_block_buffer_runtime(); // paranoia. Buffer is empty now - so reset accumulated time to zero.
   #endif
 
@@ -89,6 +89,17 @@ typedef struct {
   uint16_t power_exit;      // exit power for the laser
 } block_inline_laser_t;
 
+/**
+ * Velocity proportional (M4) laser power, precomputed by the planner so
+ * the stepper ISR only needs a multiply and a shift per rate update:
+ *
+ *   power = base + (step_rate * factor) >> 16
+ */
+typedef struct {
+  uint16_t accel_base, decel_base;      // Power at zero step rate
+  uint32_t accel_factor, decel_factor;  // Power per step/s, 16.16 fixed point
+} laser_ramp_t;
+
 /**
  * struct block_t
  *
@@ -157,6 +168,9 @@ typedef struct block_t {
              max_adv_steps,                 // max. advance steps to get cruising speed pressure (not always nominal_speed!)
              final_adv_steps;               // advance steps due to exit speed
     float e_D_ratio;
+    #if ENABLED(LIN_ADVANCE_UNIFIED)
+      uint32_t advance_scale;               // advance steps per step/s of step_event rate, 16.16 fixed point
+    #endif
   #endif
 
   uint32_t nominal_rate,                    // The nominal step rate for this block in step_events/sec
@@ -175,8 +189,16 @@ typedef struct block_t {
   uint32_t segment_time_us;
 
   uint32_t filePos;                       // position of gcode of this block in the file
+  #if ENABLED(MOVE_COALESCING)
+    uint32_t filePosFirst;                // first line of a coalesced run, filePos otherwise
+  #endif
 
   block_inline_laser_t laser;
+  laser_ramp_t laser_ramp;
+
+  #if ENABLED(LASER_RASTER_MODE)
+    uint8_t raster_slot;                  // Pixel powers of a G7 scanline, LASER_RASTER_SLOT_NONE if not raster
+  #endif
 
 } block_t;
 
@@ -245,6 +267,16 @@ typedef struct {
   #endif
 } skew_factor_t;
 
+#if ENABLED(JOB_ALIGNMENT)
+  // rotate the job about center, then move it by offset, in machine XY
+  typedef struct {
+    bool  active;
+    float cos_r, sin_r;
+    float center[XY];
+    float offset[XY];
+  } job_transform_t;
+#endif
+
 class FTMotion;
 class Planner {
   friend class FTMotion;
@@ -286,11 +318,24 @@ class Planner {
                    volumetric_multiplier[EXTRUDERS];  // Reciprocal of cross-sectional area of filament (in mm^2). Pre-calculated to reduce computation in the planner
                                                       // May be auto-adjusted by a filament width sensor
     #endif
+    #if ENABLED(VOLUMETRIC_FLOW_LIMIT)
+      static float volumetric_extruder_limit[EXTRUDERS],          // (mm³/s) Max melt rate of each hotend, 0 for no limit
+                   volumetric_extruder_feedrate_limit[EXTRUDERS]; // (mm/s) Same limit as filament speed
+    #endif
     static bool is_user_set_lead;                        // M92 Specifies whether to use a user-defined value
     static planner_settings_t settings;
 
     static laser_state_t laser_inline;
 
+    #if ENABLED(MOVE_COALESCING)
+      static uint32_t file_pos_override,        // Line to record in blocks instead of the executing command
+                      file_pos_first_override;  // First line of the coalesced run the blocks are made of
+    #endif
+
+    #if ENABLED(LASER_RASTER_MODE)
+      static uint8_t raster_slot;               // Raster slot for the next block, set by G7
+    #endif
+
     static uint32_t max_acceleration_steps_per_s2[X_TO_EN]; // (steps/s^2) Derived from mm_per_s2
     static float steps_to_mm[X_TO_EN];          // Millimeters per step
 
@@ -340,6 +385,9 @@ class Planner {
     #endif
 
     static skew_factor_t skew_factor;
+    #if ENABLED(JOB_ALIGNMENT)
+      static job_transform_t job_transform;
+    #endif
     static float min_planner_speed;
     #if ENABLED(ABORT_ON_ENDSTOP_HIT_FEATURE_ENABLED)
       static bool abort_on_endstop_hit;
@@ -388,7 +436,7 @@ class Planner {
       static uint32_t axis_segment_time_us[2][3];
     #endif
 
-    #if ENABLED(ULTRA_LCD)
+    #if EITHER(ULTRA_LCD, IDLE_NOZZLE_PREHEAT)
       volatile static uint32_t block_buffer_runtime_us; //Theoretical block buffer runtime in µs
     #endif
 
@@ -424,6 +472,13 @@ class Planner {
       );
     }
 
+    #if ENABLED(VOLUMETRIC_FLOW_LIMIT)
+      static void set_volumetric_extruder_limit(const uint8_t e, const float v) {
+        volumetric_extruder_limit[e] = v;
+        volumetric_extruder_feedrate_limit[e] = v / CIRCLE_AREA(float(VOLUMETRIC_FLOW_FILAMENT_DIA) * 0.5f);
+      }
+    #endif
+
     // Manage fans, paste pressure, etc.
     static void check_axes_activity();
 
@@ -518,6 +573,34 @@ class Planner {
 
     #endif // SKEW_CORRECTION
 
+    #if ENABLED(JOB_ALIGNMENT)
+
+      FORCE_INLINE static void align(float &cx, float &cy) {
+        if (!job_transform.active) return;
+        const float dx = cx - job_transform.center[X_AXIS], dy = cy - job_transform.center[Y_AXIS];
+        cx = job_transform.center[X_AXIS] + job_transform.offset[X_AXIS] + dx * job_transform.cos_r - dy * job_transform.sin_r;
+        cy = job_transform.center[Y_AXIS] + job_transform.offset[Y_AXIS] + dx * job_transform.sin_r + dy * job_transform.cos_r;
+      }
+      FORCE_INLINE static void align(float raw[XY]) { align(raw[X_AXIS], raw[Y_AXIS]); }
+
+      FORCE_INLINE static void unalign(float &cx, float &cy) {
+        if (!job_transform.active) return;
+        const float dx = cx - job_transform.center[X_AXIS] - job_transform.offset[X_AXIS],
+                    dy = cy - job_transform.center[Y_AXIS] - job_transform.offset[Y_AXIS];
+        cx = job_transform.center[X_AXIS] + dx * job_transform.cos_r + dy * job_transform.sin_r;
+        cy = job_transform.center[Y_AXIS] - dx * job_transform.sin_r + dy * job_transform.cos_r;
+      }
+      FORCE_INLINE static void unalign(float raw[XY]) { unalign(raw[X_AXIS], raw[Y_AXIS]); }
+
+      // Soft endstops clamp the job XY, a turned or moved job may still reach past the machine travel
+      FORCE_INLINE static void align_limit(float raw[XY]) {
+        if (!job_transform.active) return;
+        LIMIT(raw[X_AXIS], base_min_pos(X_AXIS), base_max_pos(X_AXIS));
+        LIMIT(raw[Y_AXIS], base_min_pos(Y_AXIS), base_max_pos(Y_AXIS));
+      }
+
+    #endif // JOB_ALIGNMENT
+
     #if HAS_LEVELING
       /**
        * Apply leveling to transform a cartesian position
@@ -548,6 +631,10 @@ class Planner {
           #endif
         #endif
       ) {
+        #if ENABLED(JOB_ALIGNMENT)
+          align(pos);
+          align_limit(pos);
+        #endif
         #if ENABLED(SKEW_CORRECTION)
           skew(pos);
         #endif
@@ -580,6 +667,9 @@ class Planner {
         #if ENABLED(SKEW_CORRECTION)
           unskew(pos);
         #endif
+        #if ENABLED(JOB_ALIGNMENT)
+          unalign(pos);
+        #endif
       }
     #endif // HAS_POSITION_MODIFIERS
 
@@ -831,7 +921,7 @@ FORCE_INLINE static bool has_blocks_queued() { return (block_buffer_head != bloc
         block_buffer_tail = next_block_index(block_buffer_tail);
     }
 
-    #if ENABLED(ULTRA_LCD)
+    #if EITHER(ULTRA_LCD, IDLE_NOZZLE_PREHEAT)
 
       static uint16_t block_buffer_runtime() {
         #ifdef __AVR__
@@ -943,6 +1033,7 @@ FORCE_INLINE static bool has_blocks_queued() { return (block_buffer_head != bloc
     #endif
 
     static void calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor);
+    static void set_laser_ramp(uint16_t &base, uint32_t &factor, const uint16_t power, const uint16_t end_power, const uint32_t nominal_rate, const bool offset_ramp);
 
     static void reverse_pass_kernel(block_t* const current, const block_t * const next);
     static void forward_pass_kernel(const block_t * const previous, block_t* const current, uint8_t block_index);
@@ -39,10 +39,15 @@
 #include "../core/language.h"
 #include "../gcode/queue.h"
 
-// See the meaning in the documentation of cubic_b_spline().
-#define MIN_STEP 0.002f
-#define MAX_STEP 0.1f
-#define SIGMA 0.1f
+#ifndef BEZIER_CHORDAL_ERROR_MM
+  #define BEZIER_CHORDAL_ERROR_MM 0.01f
+#endif
+#ifndef BEZIER_MIN_SEGMENT_MM
+  #define BEZIER_MIN_SEGMENT_MM 0.1f
+#endif
+#ifndef BEZIER_MAX_SEGMENT_MM
+  #define BEZIER_MAX_SEGMENT_MM 5.0f
+#endif
 
 // Compute the linear interpolation between two real numbers.
 static inline float interp(const float &a, const float &b, const float &t) { return (1 - t) * a + t * b; }
@@ -63,65 +68,125 @@ static inline float eval_bezier(const float &a, const float &b, const float &c,
 }
 
 /**
- * We approximate Euclidean distance with the sum of the coordinates
- * offset (so-called "norm 1"), which is quicker to compute.
- */
-static inline float dist1(const float &x1, const float &y1, const float &x2, const float &y2) { return ABS(x1 - x2) + ABS(y1 - y2); }
-
-/**
- * The algorithm for computing the step is loosely based on the one in Kig
- * (See https://sources.debian.net/src/kig/4:15.08.3-1/misc/kigpainter.cpp/#L759)
- * However, we do not use the stack.
+ * Chordal subdivision of a planar cubic Bézier curve.
  *
- * The algorithm goes as it follows: the parameters t runs from 0.0 to
- * 1.0 describing the curve, which is evaluated by eval_bezier(). At
- * each iteration we have to choose a step, i.e., the increment of the
- * t variable. By default the step of the previous iteration is taken,
- * and then it is enlarged or reduced depending on how straight the
- * curve locally is. The step is always clamped between MIN_STEP/2 and
- * 2*MAX_STEP. MAX_STEP is taken at the first iteration.
+ * The chord replacing the curve on [t, t+h] deviates from it by at most
+ * h^2/8 * max|B''| over that interval. For a cubic, B''(t) is linear in t:
  *
- * For some t, the step value is considered acceptable if the curve in
- * the interval [t, t+step] is sufficiently straight, i.e.,
- * sufficiently close to linear interpolation. In practice the
- * following test is performed: the distance between eval_bezier(...,
- * t+step/2) is evaluated and compared with 0.5*(eval_bezier(...,
- * t)+eval_bezier(..., t+step)). If it is smaller than SIGMA, then the
- * step value is considered acceptable, otherwise it is not. The code
- * seeks to find the larger step value which is considered acceptable.
+ *   B''(t) = 6 * ((1-t) * (P0 - 2P1 + P2) + t * (P1 - 2P2 + P3))
  *
- * At every iteration the recorded step value is considered and then
- * iteratively halved until it becomes acceptable. If it was already
- * acceptable in the beginning (i.e., no halving were done), then
- * maybe it was necessary to enlarge it; then it is iteratively
- * doubled while it remains acceptable. The last acceptable value
- * found is taken, provided that it is between MIN_STEP and MAX_STEP
- * and does not bring t over 1.0.
+ * so its maximum magnitude on any interval is reached at one of the ends.
+ * This gives the longest acceptable step in closed form, without the
+ * trial-and-error bisection of the previous subdivider, and emits the
+ * smallest number of segments that stays within BEZIER_CHORDAL_ERROR_MM.
+ *
+ * The segment length is then kept between BEZIER_MIN_SEGMENT_MM, to avoid
+ * flooding the planner with tiny blocks on tight curves, and
+ * BEZIER_MAX_SEGMENT_MM, so that leveled moves keep following the mesh.
+ */
+class BezierSubdivider {
+  public:
+    BezierSubdivider(const float position[NUM_AXIS], const float target[NUM_AXIS], const float offset[4]) {
+      p[0][X_AXIS] = position[X_AXIS];
+      p[0][Y_AXIS] = position[Y_AXIS];
+      p[1][X_AXIS] = position[X_AXIS] + offset[0];
+      p[1][Y_AXIS] = position[Y_AXIS] + offset[1];
+      p[2][X_AXIS] = target[X_AXIS] + offset[2];
+      p[2][Y_AXIS] = target[Y_AXIS] + offset[3];
+      p[3][X_AXIS] = target[X_AXIS];
+      p[3][Y_AXIS] = target[Y_AXIS];
+      LOOP_L_N(i, 2) {
+        d2_start[i] = 6 * (p[0][i] - 2 * p[1][i] + p[2][i]);
+        d2_end[i]   = 6 * (p[1][i] - 2 * p[2][i] + p[3][i]);
+      }
+    }
+
+    void eval(const float t, float (&out)[2]) const {
+      LOOP_L_N(i, 2) out[i] = eval_bezier(p[0][i], p[1][i], p[2][i], p[3][i], t);
+    }
+
+    // Advance from t (at point 'from') to the next segment end. Returns the new t.
+    float next(const float t, const float (&from)[2], float (&to)[2]) const {
+      const float remaining = 1 - t;
+      float h = remaining;
+      const float a_t = accel(t), a_h = _MAX(a_t, accel(1));
+      if (a_h > 0) {
+        // Conservative step, using the bound over the whole remaining curve
+        h = SQRT(8 * (BEZIER_CHORDAL_ERROR_MM) / a_h);
+        // Try the step given by the local bound and keep it if it still holds
+        const float h_local = SQRT(8 * (BEZIER_CHORDAL_ERROR_MM) / _MAX(a_t, accel(_MIN(t + h, 1.0f))));
+        if (h_local < remaining && sq(h_local) * 0.125f * _MAX(a_t, accel(t + h_local)) <= (BEZIER_CHORDAL_ERROR_MM))
+          h = h_local;
+        NOMORE(h, remaining);
+      }
+
+      eval(t + h, to);
+      const float len = HYPOT(to[X_AXIS] - from[X_AXIS], to[Y_AXIS] - from[Y_AXIS]);
+      if (len > (BEZIER_MAX_SEGMENT_MM))
+        h *= (BEZIER_MAX_SEGMENT_MM) / len;
+      else if (len < (BEZIER_MIN_SEGMENT_MM) && h < remaining && len > 0)
+        h *= (BEZIER_MIN_SEGMENT_MM) / len;
+      else
+        return t + h;
+
+      if (h >= remaining) {
+        to[X_AXIS] = p[3][X_AXIS];
+        to[Y_AXIS] = p[3][Y_AXIS];
+        return 1;
+      }
+      eval(t + h, to);
+      return t + h;
+    }
+
+  private:
+    // Magnitude of the second derivative at t
+    float accel(const float t) const {
+      return HYPOT(interp(d2_start[X_AXIS], d2_end[X_AXIS], t), interp(d2_start[Y_AXIS], d2_end[Y_AXIS], t));
+    }
+
+    float p[4][2];
+    float d2_start[2], d2_end[2];
+};
+
+/**
+ * Buffer a cubic Bézier curve as a series of linear segments.
  *
- * Caveat: this algorithm is not perfect, since it can happen that a
- * step is considered acceptable even when the curve is not linear at
- * all in the interval [t, t+step] (but its mid point coincides "by
- * chance" with the midpoint according to the parametrization). This
- * kind of glitches can be eliminated with proper first derivative
- * estimates; however, given the improbability of such configurations,
- * the mitigation offered by MIN_STEP and the small computational
- * power available on Arduino, I think it is not wise to implement it.
+ * Subdivision is done twice: the first pass only sums the segment lengths
+ * so that Z and E can be distributed along the curve by distance instead
+ * of by the parameter t, which is not linear in the distance.
  */
 void cubic_b_spline(const float position[NUM_AXIS], const float target[NUM_AXIS], const float offset[4], float fr_mm_s, uint8_t extruder) {
-  // Absolute first and second control points are recovered.
-  const float first0 = position[X_AXIS] + offset[0],
-              first1 = position[Y_AXIS] + offset[1],
-              second0 = target[X_AXIS] + offset[2],
-              second1 = target[Y_AXIS] + offset[3];
-  float t = 0;
-
-  float bez_target[4];
-  bez_target[X_AXIS] = position[X_AXIS];
-  bez_target[Y_AXIS] = position[Y_AXIS];
-  float step = MAX_STEP;
+  const BezierSubdivider curve(position, target, offset);
+
+  float t = 0, from[2] = { position[X_AXIS], position[Y_AXIS] }, to[2], total_mm = 0;
+  while (t < 1) {
+    t = curve.next(t, from, to);
+    total_mm += HYPOT(to[X_AXIS] - from[X_AXIS], to[Y_AXIS] - from[Y_AXIS]);
+    COPY(from, to);
+  }
+
+  float bez_target[X_TO_E];
+
+  // no XY to follow, e.g. a G5 moving only Z or E, go straight to the target
+  if (total_mm < 0.001f) {
+    LOOP_X_TO_E(i) bez_target[i] = target[i];
+    apply_motion_limits(bez_target);
+
+    #if HAS_LEVELING && !PLANNER_LEVELING
+      planner.apply_leveling(bez_target);
+    #endif
+
+    planner.buffer_line(bez_target, fr_mm_s, extruder);
+    return;
+  }
 
+  const float inv_total_mm = 1.0f / total_mm;
   millis_t next_idle_ms = millis() + 200UL;
 
+  float done_mm = 0;
+  t = 0;
+  from[X_AXIS] = position[X_AXIS];
+  from[Y_AXIS] = position[Y_AXIS];
   while (t < 1) {
 
     thermalManager.manage_heater();
@@ -131,73 +196,25 @@ void cubic_b_spline(const float position[NUM_AXIS], const float target[NUM_AXIS]
       idle();
     }
 
-    // First try to reduce the step in order to make it sufficiently
-    // close to a linear interpolation.
-    bool did_reduce = false;
-    float new_t = t + step;
-    NOMORE(new_t, 1);
-    float new_pos0 = eval_bezier(position[X_AXIS], first0, second0, target[X_AXIS], new_t),
-          new_pos1 = eval_bezier(position[Y_AXIS], first1, second1, target[Y_AXIS], new_t);
-    for (;;) {
-      if (new_t - t < (MIN_STEP)) break;
-      const float candidate_t = 0.5f * (t + new_t),
-                  candidate_pos0 = eval_bezier(position[X_AXIS], first0, second0, target[X_AXIS], candidate_t),
-                  candidate_pos1 = eval_bezier(position[Y_AXIS], first1, second1, target[Y_AXIS], candidate_t),
-                  interp_pos0 = 0.5f * (bez_target[X_AXIS] + new_pos0),
-                  interp_pos1 = 0.5f * (bez_target[Y_AXIS] + new_pos1);
-      if (dist1(candidate_pos0, candidate_pos1, interp_pos0, interp_pos1) <= (SIGMA)) break;
-      new_t = candidate_t;
-      new_pos0 = candidate_pos0;
-      new_pos1 = candidate_pos1;
-      did_reduce = true;
-    }
-
-    // If we did not reduce the step, maybe we should enlarge it.
-    if (!did_reduce) for (;;) {
-      if (new_t - t > MAX_STEP) break;
-      const float candidate_t = t + 2 * (new_t - t);
-      if (candidate_t >= 1) break;
-      const float candidate_pos0 = eval_bezier(position[X_AXIS], first0, second0, target[X_AXIS], candidate_t),
-                  candidate_pos1 = eval_bezier(position[Y_AXIS], first1, second1, target[Y_AXIS], candidate_t),
-                  interp_pos0 = 0.5f * (bez_target[X_AXIS] + candidate_pos0),
-                  interp_pos1 = 0.5f * (bez_target[Y_AXIS] + candidate_pos1);
-      if (dist1(new_pos0, new_pos1, interp_pos0, interp_pos1) > (SIGMA)) break;
-      new_t = candidate_t;
-      new_pos0 = candidate_pos0;
-      new_pos1 = candidate_pos1;
-    }
-
-    // Check some postcondition; they are disabled in the actual
-    // Marlin build, but if you test the same code on a computer you
-    // may want to check they are respect.
-    /*
-      assert(new_t <= 1.0);
-      if (new_t < 1.0) {
-        assert(new_t - t >= (MIN_STEP) / 2.0);
-        assert(new_t - t <= (MAX_STEP) * 2.0);
-      }
-    */
-
-    step = new_t - t;
-    t = new_t;
+    t = curve.next(t, from, to);
+    const float seg_mm = HYPOT(to[X_AXIS] - from[X_AXIS], to[Y_AXIS] - from[Y_AXIS]);
+    done_mm += seg_mm;
+    const float fraction = t < 1 ? done_mm * inv_total_mm : 1;
+    COPY(from, to);
 
     // Compute and send new position
-    bez_target[X_AXIS] = new_pos0;
-    bez_target[Y_AXIS] = new_pos1;
-    // FIXME. The following two are wrong, since the parameter t is
-    // not linear in the distance.
-    bez_target[Z_AXIS] = interp(position[Z_AXIS], target[Z_AXIS], t);
-    bez_target[E_AXIS] = interp(position[E_AXIS], target[E_AXIS], t);
+    bez_target[X_AXIS] = to[X_AXIS];
+    bez_target[Y_AXIS] = to[Y_AXIS];
+    bez_target[Z_AXIS] = interp(position[Z_AXIS], target[Z_AXIS], fraction);
+    bez_target[B_AXIS] = interp(position[B_AXIS], target[B_AXIS], fraction);
+    bez_target[E_AXIS] = interp(position[E_AXIS], target[E_AXIS], fraction);
     apply_motion_limits(bez_target);
 
     #if HAS_LEVELING && !PLANNER_LEVELING
-      float pos[XYZE] = { bez_target[X_AXIS], bez_target[Y_AXIS], bez_target[Z_AXIS], bez_target[E_AXIS] };
-      planner.apply_leveling(pos);
-    #else
-      const float (&pos)[XYZE] = bez_target;
+      planner.apply_leveling(bez_target);
     #endif
 
-    if (!planner.buffer_line(pos, fr_mm_s, active_extruder, step))
+    if (!planner.buffer_line(bez_target, fr_mm_s, extruder, seg_mm))
       break;
   }
 }
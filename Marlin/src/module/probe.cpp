@@ -594,7 +594,7 @@ static float run_z_probe() {
   #if MULTIPLE_PROBING == 2
 
     // Do a first probe at the fast speed
-    if (do_probe_move(z_probe_low_point, MMM_TO_MMS(Z_PROBE_SPEED_FAST))) {
+    if (do_probe_move(z_probe_low_point, MMM_TO_MMS(z_probe_speed_fast))) {
       if (DEBUGGING(LEVELING)) {
         DEBUG_ECHOLNPGM("FAST Probe fail!");
         DEBUG_POS("<<< run_z_probe", current_position);
@@ -607,22 +607,22 @@ static float run_z_probe() {
     if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPAIR("1st Probe Z:", first_probe_z);
 
     // move up to make clearance for the probe
-    do_blocking_move_to_z(current_position[Z_AXIS] + Z_CLEARANCE_MULTI_PROBE, MMM_TO_MMS(Z_PROBE_SPEED_FAST));
+    do_blocking_move_to_z(current_position[Z_AXIS] + Z_CLEARANCE_MULTI_PROBE, MMM_TO_MMS(z_probe_speed_fast));
 
-  #elif Z_PROBE_SPEED_FAST != Z_PROBE_SPEED_SLOW
+  #elif Z_PROBE_SPEED_FAST != Z_PROBE_SPEED_SLOW || ENABLED(PROBE_SPEED_TUNING)
 
     // If the nozzle is well over the travel height then
     // move down quickly before doing the slow probe
     const float z = Z_CLEARANCE_DEPLOY_PROBE + 5.0 + (zprobe_zoffset < 0 ? -zprobe_zoffset : 0);
     if (current_position[Z_AXIS] > z) {
       // If we don't make it to the z position (i.e. the probe triggered), move up to make clearance for the probe
-      if (!do_probe_move(z, MMM_TO_MMS(Z_PROBE_SPEED_FAST)))
-        do_blocking_move_to_z(current_position[Z_AXIS] + Z_CLEARANCE_BETWEEN_PROBES, MMM_TO_MMS(Z_PROBE_SPEED_SLOW));
+      if (!do_probe_move(z, MMM_TO_MMS(z_probe_speed_fast)))
+        do_blocking_move_to_z(current_position[Z_AXIS] + Z_CLEARANCE_BETWEEN_PROBES, MMM_TO_MMS(z_probe_speed_slow));
     }
   #endif
 
   #if MULTIPLE_PROBING > 2
-  float probe_speed = MMM_TO_MMS(Z_PROBE_SPEED_SLOW);
+  float probe_speed = MMM_TO_MMS(z_probe_speed_slow);
   float clearance = Z_CLEARANCE_MULTI_PROBE;
   // float probes[MULTIPLE_PROBING];
   float probes_total = 0;
@@ -659,7 +659,7 @@ static float run_z_probe() {
       }
       last_probed_z = current_position[Z_AXIS];
 
-      if (p > 1) do_blocking_move_to_z(current_position[Z_AXIS] + clearance, MMM_TO_MMS(Z_PROBE_SPEED_SLOW));
+      if (p > 1) do_blocking_move_to_z(current_position[Z_AXIS] + clearance, MMM_TO_MMS(z_probe_speed_slow));
 
       // raise Z until probe is not triggered
       if (TEST(endstops.trigger_state(),
@@ -670,7 +670,7 @@ static float run_z_probe() {
         #endif
       )) {
         LOG_E("probe is triggered before probed! raise again!\n");
-        do_blocking_move_to_z(current_position[Z_AXIS] + clearance, MMM_TO_MMS(Z_PROBE_SPEED_SLOW));
+        do_blocking_move_to_z(current_position[Z_AXIS] + clearance, MMM_TO_MMS(z_probe_speed_slow));
       }
       clearance -= 0.5;
     }
@@ -763,7 +763,7 @@ float probe_pt(const float &rx, const float &ry, const ProbePtRaise raise_after/
 
     const bool big_raise = raise_after == PROBE_PT_BIG_RAISE;
     if (big_raise || raise_after == PROBE_PT_RAISE)
-      do_blocking_move_to_z(current_position[Z_AXIS] + (big_raise ? 25 : Z_CLEARANCE_BETWEEN_PROBES), MMM_TO_MMS(Z_PROBE_SPEED_FAST));
+      do_blocking_move_to_z(current_position[Z_AXIS] + (big_raise ? 25 : Z_CLEARANCE_BETWEEN_PROBES), MMM_TO_MMS(z_probe_speed_fast));
     else if (raise_after == PROBE_PT_STOW) {
       if (STOW_PROBE()) {
       LOG_E("stow failed!\n");
@@ -793,6 +793,192 @@ float probe_pt(const float &rx, const float &ry, const ProbePtRaise raise_after/
   return measured_z;
 }
 
+#if ENABLED(QUICK_AUTO_PROBING)
+
+  // the probe state comes over CAN, give the release report some time
+  #define QUICK_PROBING_RELEASE_MS  200
+
+  /**
+   * After the raise of a quick probe, wait for the active probe sensor to
+   * release. A probe still triggered would stop the next probe at once.
+   */
+  static bool quick_probe_released() {
+    const millis_t timeout = millis() + QUICK_PROBING_RELEASE_MS;
+
+    while (TEST(printer1->probe_state(), 0) != Z_MIN_PROBE_ENDSTOP_INVERTING) {
+      if (ELAPSED(millis(), timeout)) return false;
+      idle();
+    }
+
+    return true;
+  }
+
+  /**
+   * Probe at the given XY, probe or nozzle relative as probe_pt(), from
+   * start_z instead of the clearance height. One approach and one slow
+   * probe, Z is left at the trigger height, no raise after.
+   */
+  float probe_pt_quick(const float &rx, const float &ry, const float &start_z, const bool probe_relative/*=true*/) {
+    float nx = rx, ny = ry;
+
+    if (probe_relative) {
+      if (!position_is_reachable_by_probe(rx, ry)) {
+        LOG_E("Point is out of workspace!\n");
+        return NAN;
+      }
+      nx -= (X_PROBE_OFFSET_FROM_EXTRUDER);
+      ny -= (Y_PROBE_OFFSET_FROM_EXTRUDER);
+    }
+    else if (!position_is_reachable(nx, ny)) {
+      LOG_E("Point is out of workspace!\n");
+      return NAN;
+    }
+
+    // raises before XY, lowers after XY
+    do_blocking_move_to(nx, ny, start_z, XY_PROBE_FEEDRATE_MM_S);
+
+    if (DEPLOY_PROBE()) {
+      LOG_E("deploy failed!\n");
+      return NAN;
+    }
+
+    const float z_probe_low_point = -zprobe_zoffset + Z_PROBE_LOW_POINT;
+    float measured_z = NAN;
+
+    if (do_probe_move(z_probe_low_point, MMM_TO_MMS(z_probe_speed_slow))) {
+      LOG_E("probe didn't triggered\n");
+    }
+    else {
+      const float approach_z = current_position[Z_AXIS];
+
+      do_blocking_move_to_z(approach_z + QUICK_PROBING_RECHECK, MMM_TO_MMS(z_probe_speed_slow));
+
+      if (!quick_probe_released()) {
+        LOG_E("probe didn't release\n");
+      }
+      // same slow speed as the repeated probes of run_z_probe()
+      else if (do_probe_move(z_probe_low_point, QUICK_PROBING_SPEED)) {
+        LOG_E("probe didn't triggered\n");
+      }
+      else {
+        if (ABS(current_position[Z_AXIS] - approach_z) > 0.2)
+          LOG_W("larger clearance between 2 probe!\n");
+        measured_z = current_position[Z_AXIS] + zprobe_zoffset;
+      }
+    }
+
+    LOG_I("quick probed X: %.2f, Y: %.2f, Z: %.3f\n", rx, ry, measured_z);
+
+    if (isnan(measured_z)) {
+      STOW_PROBE();
+      SERIAL_ERROR_MSG(MSG_ERR_PROBING_FAILED);
+    }
+
+    return measured_z;
+  }
+
+#endif // QUICK_AUTO_PROBING
+
+#if ENABLED(PROBE_SPEED_TUNING)
+
+  float z_probe_speed_fast = Z_PROBE_SPEED_FAST,
+        z_probe_speed_slow = Z_PROBE_SPEED_SLOW;
+
+  /**
+   * Probe n times at the current XY at fr_mm_s, each one from raise above
+   * the last stop, and put the stops into z[]. The stop comes from the
+   * stepper counts, so it is as late as the trigger reached Endstops.
+   * Return false if the probe didn't trigger.
+   */
+  bool probe_stops(const float fr_mm_s, const float raise, float z[], const uint8_t n) {
+    const float z_probe_low_point = -zprobe_zoffset + Z_PROBE_LOW_POINT;
+
+    for (uint8_t i = 0; i < n; i++) {
+      do_blocking_move_to_z(current_position[Z_AXIS] + raise, MMM_TO_MMS(Z_PROBE_SPEED_FAST));
+
+      if (do_probe_move(z_probe_low_point, fr_mm_s)) {
+        LOG_E("probe didn't triggered\n");
+        return false;
+      }
+
+      z[i] = current_position[Z_AXIS] + zprobe_zoffset;
+    }
+
+    return true;
+  }
+
+#endif // PROBE_SPEED_TUNING
+
+#if ENABLED(DUAL_PROBE_CAPTURE)
+
+  /**
+   * Probe at the given nozzle XY like probe_pt_quick(), but the slow probe
+   * goes on until the left nozzle touches the bed. The proximity switch is
+   * captured on the way, so one descent gives both heights.
+   * Return the proximity switch height, NAN if either one failed.
+   */
+  float probe_pt_capture(const float &nx, const float &ny, const float &start_z, float &touch_z) {
+    touch_z = NAN;
+
+    if (!position_is_reachable(nx, ny)) {
+      LOG_E("Point is out of workspace!\n");
+      return NAN;
+    }
+
+    do_blocking_move_to(nx, ny, start_z, XY_PROBE_FEEDRATE_MM_S);
+
+    if (DEPLOY_PROBE()) {
+      LOG_E("deploy failed!\n");
+      return NAN;
+    }
+
+    const float z_probe_low_point = -zprobe_zoffset + Z_PROBE_LOW_POINT;
+    float measured_z = NAN;
+
+    printer1->SelectProbeSensor(PROBE_SENSOR_PROXIMITY_SWITCH);
+
+    if (do_probe_move(z_probe_low_point, MMM_TO_MMS(z_probe_speed_slow))) {
+      LOG_E("probe didn't triggered\n");
+    }
+    else {
+      do_blocking_move_to_z(current_position[Z_AXIS] + QUICK_PROBING_RECHECK, MMM_TO_MMS(z_probe_speed_slow));
+
+      // the capture waits for the switch to trigger again, so it has to be released first
+      if (!quick_probe_released()) {
+        LOG_E("probe didn't release\n");
+      }
+      else {
+        // the switch triggers again on the way down, the nozzle stops the move
+        printer1->ArmProbeCapture(PROBE_SENSOR_PROXIMITY_SWITCH);
+        printer1->SelectProbeSensor(PROBE_SENSOR_LEFT_OPTOCOUPLER);
+
+        // same slow speed as the measuring probe of probe_pt_quick()
+        if (do_probe_move(z_probe_low_point, QUICK_PROBING_SPEED)) {
+          LOG_E("nozzle didn't touch\n");
+        }
+        else {
+          touch_z = current_position[Z_AXIS] + zprobe_zoffset;
+          measured_z = printer1->probe_capture() + zprobe_zoffset;
+        }
+
+        printer1->DisarmProbeCapture();
+        printer1->SelectProbeSensor(PROBE_SENSOR_PROXIMITY_SWITCH);
+      }
+    }
+
+    LOG_I("captured X: %.2f, Y: %.2f, Z: %.3f, touch: %.3f\n", nx, ny, measured_z, touch_z);
+
+    if (isnan(measured_z) || isnan(touch_z)) {
+      measured_z = touch_z = NAN;
+      STOW_PROBE();
+      SERIAL_ERROR_MSG(MSG_ERR_PROBING_FAILED);
+    }
+
+    return measured_z;
+  }
+
+#endif // DUAL_PROBE_CAPTURE
+
 #if HAS_Z_SERVO_PROBE
 
   void servo_probe_init() {
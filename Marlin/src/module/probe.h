@@ -44,6 +44,18 @@
     PROBE_PT_BIG_RAISE  // Raise to big clearance after run_z_probe
   };
   float probe_pt(const float &rx, const float &ry, const ProbePtRaise raise_after=PROBE_PT_NONE, const uint8_t verbose_level=0, const bool probe_relative=true);
+  #if ENABLED(QUICK_AUTO_PROBING)
+    float probe_pt_quick(const float &rx, const float &ry, const float &start_z, const bool probe_relative=true);
+  #endif
+  #if ENABLED(DUAL_PROBE_CAPTURE)
+    float probe_pt_capture(const float &nx, const float &ny, const float &start_z, float &touch_z);
+  #endif
+  #if ENABLED(PROBE_SPEED_TUNING)
+    extern float z_probe_speed_fast, z_probe_speed_slow;  // (mm/m) M1037
+    bool probe_stops(const float fr_mm_s, const float raise, float z[], const uint8_t n);
+  #else
+    constexpr float z_probe_speed_fast = Z_PROBE_SPEED_FAST, z_probe_speed_slow = Z_PROBE_SPEED_SLOW;
+  #endif
   #define DEPLOY_PROBE() set_probe_deployed(true)
   #define STOW_PROBE() set_probe_deployed(false)
   #if HAS_HEATED_BED && ENABLED(WAIT_FOR_BED_HEATER)
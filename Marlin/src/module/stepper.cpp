@@ -104,6 +104,7 @@ Stepper stepper; // Singleton
 #include "../../../snapmaker/src/module/emergency_stop.h"
 #include "../../../snapmaker/src/snapmaker.h"
 #include "../../../snapmaker/src/module/toolhead_laser.h"
+#include "../../../snapmaker/src/service/laser_raster.h"
 
 #if MB(ALLIGATOR)
   #include "../feature/dac/dac_dac084s085.h"
@@ -219,6 +220,14 @@ uint32_t Stepper::nextMainISR = 0;
 
   bool Stepper::LA_use_advance_lead;
 
+  #if ENABLED(LIN_ADVANCE_UNIFIED)
+    uint32_t Stepper::LA_advance_scale;
+    constexpr uint32_t LA_SMOOTH_TICKS = uint32_t((LIN_ADVANCE_SMOOTH_TIME) * (STEPPER_TIMER_RATE));
+  #endif
+
+  uint32_t Stepper::LA_isr_count = 0,
+           Stepper::LA_main_isr_count = 0;
+
 #endif // LIN_ADVANCE
 
 int32_t Stepper::ticks_nominal = -1;
@@ -238,6 +247,15 @@ Stepper::stepper_laser_t Stepper::laser_trap = {
   .cruise_set = false
 };
 
+#if ENABLED(LASER_RASTER_MODE)
+  Stepper::stepper_raster_t Stepper::laser_scan = {
+    .pwm = nullptr,
+    .pixel_rate = 0,
+    .pixels = 0,
+    .index = 0
+  };
+#endif
+
 #define DUAL_ENDSTOP_APPLY_STEP(A,V)                                                                                        \
   if (separate_multi_axis) {                                                                                                \
     if (A##_HOME_DIR < 0) {                                                                                                 \
@@ -1403,7 +1421,10 @@ void Stepper::isr() {
       // Run main stepping pulse phase ISR if we have to
       if (!nextMainISR) Stepper::stepper_pulse_phase_isr();
 
-      #if ENABLED(LIN_ADVANCE)
+      #if ENABLED(LIN_ADVANCE_UNIFIED)
+        // E steps of the move and of the advance go out right after the main pulses
+        if (LA_steps) Stepper::advance_isr();
+      #elif ENABLED(LIN_ADVANCE)
         // Run linear advance stepper ISR if we have to
         if (!nextAdvanceISR) nextAdvanceISR = Stepper::advance_isr();
       #endif
@@ -1414,7 +1435,7 @@ void Stepper::isr() {
       if (!nextMainISR) nextMainISR = Stepper::stepper_block_phase_isr();
 
       interval =
-        #if ENABLED(LIN_ADVANCE)
+        #if ENABLED(LIN_ADVANCE) && DISABLED(LIN_ADVANCE_UNIFIED)
           MIN(nextAdvanceISR, nextMainISR)  // Nearest time interval
         #else
           nextMainISR                       // Remaining stepper ISR time
@@ -1427,7 +1448,7 @@ void Stepper::isr() {
       // Compute the time remaining for the main isr
       nextMainISR -= interval;
 
-      #if ENABLED(LIN_ADVANCE)
+      #if ENABLED(LIN_ADVANCE) && DISABLED(LIN_ADVANCE_UNIFIED)
         // Compute the time remaining for the advance isr
         if (nextAdvanceISR != LA_ADV_NEVER) nextAdvanceISR -= interval;
       #endif
@@ -1522,6 +1543,13 @@ void Stepper::stepper_pulse_phase_isr() {
   if (abort_current_block || !Running) {
     abort_current_block = false;
     if (current_block) {
+      #if ENABLED(LASER_RASTER_MODE)
+        if (laser_scan.pwm) {
+          laser->TurnOn_ISR(0, false, 0);
+          laser_raster.Release(current_block->raster_slot);
+          laser_scan.pwm = nullptr;
+        }
+      #endif
       axis_did_move = 0;
       current_block = NULL;
       planner.discard_current_block();
@@ -1658,6 +1686,16 @@ void Stepper::stepper_pulse_phase_isr() {
   } while (events_to_do);
 }
 
+// Laser power for the given step rate on a trapezoid ramp, from the
+// coefficients the planner precomputed for the current block
+FORCE_INLINE uint16_t Stepper::laser_ramp_power(const uint16_t base, const uint32_t factor, uint32_t step_rate) {
+  NOMORE(step_rate, current_block->nominal_rate);
+  uint16_t power = base + uint16_t((step_rate * factor) >> 16);
+  if (laser->device_id() == MODULE_DEVICE_ID_LASER_RED_2W_2023 && power != 0 && power < laser->get_inline_pwm_power_floor())
+    power = laser->get_inline_pwm_power_floor();
+  return power;
+}
+
 // This is the last half of the stepper interrupt: This one processes and
 // properly schedules blocks from the planner. This is executed after creating
 // the step pulses, so it is not time critical, as pulses are already done.
@@ -1670,6 +1708,10 @@ uint32_t Stepper::stepper_block_phase_isr() {
   // If there is a current block
   if (current_block) {
 
+    #if ENABLED(LIN_ADVANCE)
+      LA_main_isr_count++;
+    #endif
+
     // If current block is finished, reset pointer
     if (step_events_completed >= step_event_count) {
       #if FILAMENT_RUNOUT_DISTANCE_MM > 0
@@ -1680,6 +1722,14 @@ uint32_t Stepper::stepper_block_phase_isr() {
       pl_recovery.SaveCmdLine(current_block->filePos);
       // pl_recovery.SaveLaserInlineState(current_block->laser.status.isEnabled, current_block->laser.status.trapezoid_power);
       pl_recovery.SaveLaserPowerInfo(current_block->laser);
+      #if ENABLED(LASER_RASTER_MODE)
+        // Scanline done, turn off and hand the slot back for the next line
+        if (laser_scan.pwm) {
+          laser->TurnOn_ISR(0, false, 0);
+          laser_raster.Release(current_block->raster_slot);
+          laser_scan.pwm = nullptr;
+        }
+      #endif
       current_block = NULL;
       planner.discard_current_block();
     }
@@ -1706,7 +1756,9 @@ uint32_t Stepper::stepper_block_phase_isr() {
         interval = calc_timer_interval(acc_step_rate, oversampling_factor, &steps_per_isr);
         acceleration_time += interval;
 
-        #if ENABLED(LIN_ADVANCE)
+        #if ENABLED(LIN_ADVANCE_UNIFIED)
+          LA_update(acc_step_rate, interval);
+        #elif ENABLED(LIN_ADVANCE)
           if (LA_use_advance_lead) {
             // Fire ISR if final adv_rate is reached
             if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
@@ -1716,22 +1768,7 @@ uint32_t Stepper::stepper_block_phase_isr() {
 
         // Update laser - Accelerating
         if (laser_trap.enabled && laser_trap.trapezoid_power) {
-          if (laser->device_id() == MODULE_DEVICE_ID_LASER_RED_2W_2023) {
-            if (current_block->laser.power > current_block->laser.power_entry) {
-              laser_trap.cur_power = (current_block->laser.power - current_block->laser.power_entry) * acc_step_rate 
-                                      / current_block->nominal_rate + current_block->laser.power_entry;
-            }
-            else {
-              laser_trap.cur_power = (current_block->laser.power * acc_step_rate) / current_block->nominal_rate + current_block->laser.power;
-            }
-            if (laser_trap.cur_power != 0 && laser_trap.cur_power < laser->get_inline_pwm_power_floor()) {
-              laser_trap.cur_power = laser->get_inline_pwm_power_floor();
-            }
-          }
-          else {
-            laser_trap.cur_power = (current_block->laser.power * acc_step_rate) / current_block->nominal_rate;
-          }
-
+          laser_trap.cur_power = laser_ramp_power(current_block->laser_ramp.accel_base, current_block->laser_ramp.accel_factor, acc_step_rate);
           laser->TurnOn_ISR(laser_trap.cur_power, current_block->laser.status.is_sync_power, current_block->laser.sync_power);
         }
       }
@@ -1772,7 +1809,9 @@ uint32_t Stepper::stepper_block_phase_isr() {
         interval = calc_timer_interval(step_rate, oversampling_factor, &steps_per_isr);
         deceleration_time += interval;
 
-        #if ENABLED(LIN_ADVANCE)
+        #if ENABLED(LIN_ADVANCE_UNIFIED)
+          LA_update(step_rate, interval);
+        #elif ENABLED(LIN_ADVANCE)
           if (LA_use_advance_lead) {
             // Wake up eISR on first deceleration loop and fire ISR if final adv_rate is reached
             if (step_events_completed <= decelerate_after + steps_per_isr || (LA_steps && LA_isr_rate != current_block->advance_speed)) {
@@ -1785,33 +1824,14 @@ uint32_t Stepper::stepper_block_phase_isr() {
 
         // Update laser - Decelerating
         if (laser_trap.enabled && laser_trap.trapezoid_power) {
-          if (laser->device_id() == MODULE_DEVICE_ID_LASER_RED_2W_2023) {
-            if (current_block->laser.power > current_block->laser.power_exit) {
-              laser_trap.cur_power = (current_block->laser.power - current_block->laser.power_exit) * step_rate
-                                    / current_block->nominal_rate + current_block->laser.power_exit;
-              if (laser_trap.cur_power < current_block->laser.power_exit) {
-                laser_trap.cur_power = current_block->laser.power_exit;
-              }
-            }
-            else {
-              laser_trap.cur_power =( current_block->laser.power * step_rate) / current_block->nominal_rate + current_block->laser.power;
-            }
-
-            if (laser_trap.cur_power != 0 && laser_trap.cur_power < laser->get_inline_pwm_power_floor()) {
-              laser_trap.cur_power = laser->get_inline_pwm_power_floor();
-            }
-          }
-          else {
-            laser_trap.cur_power = (current_block->laser.power * step_rate) / current_block->nominal_rate;
-          }
-          
+          laser_trap.cur_power = laser_ramp_power(current_block->laser_ramp.decel_base, current_block->laser_ramp.decel_factor, step_rate);
           laser->TurnOn_ISR(laser_trap.cur_power, current_block->laser.status.is_sync_power, current_block->laser.sync_power);
         }
       }
       // We must be in cruise phase otherwise
       else {
 
-        #if ENABLED(LIN_ADVANCE)
+        #if ENABLED(LIN_ADVANCE) && DISABLED(LIN_ADVANCE_UNIFIED)
           // If there are any esteps, fire the next advance_isr "now"
           if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
         #endif
@@ -1825,6 +1845,10 @@ uint32_t Stepper::stepper_block_phase_isr() {
         // The timer interval is just the nominal value for the nominal speed
         interval = ticks_nominal;
 
+        #if ENABLED(LIN_ADVANCE_UNIFIED)
+          LA_update(current_block->nominal_rate, interval);
+        #endif
+
         // Update laser - Cruising
         if (laser_trap.enabled && laser_trap.trapezoid_power) {
           if (!laser_trap.cruise_set) {
@@ -1834,6 +1858,17 @@ uint32_t Stepper::stepper_block_phase_isr() {
           }
         }
       }
+
+      #if ENABLED(LASER_RASTER_MODE)
+        // Update laser - Scanline, power follows the position rather than the time
+        if (laser_scan.pwm) {
+          const uint16_t pixel = (step_events_completed * laser_scan.pixel_rate) >> 16;
+          if (pixel != laser_scan.index && pixel < laser_scan.pixels) {
+            laser_scan.index = pixel;
+            laser->TurnOn_ISR(laser_scan.pwm[pixel], false, 0);
+          }
+        }
+      #endif
     }
   }
 
@@ -1994,14 +2029,19 @@ uint32_t Stepper::stepper_block_phase_isr() {
           if (stepper_extruder != last_moved_extruder) LA_current_adv_steps = 0;
         #endif
 
-        if ((LA_use_advance_lead = current_block->use_advance_lead)) {
-          LA_final_adv_steps = current_block->final_adv_steps;
-          LA_max_adv_steps = current_block->max_adv_steps;
-          //Start the ISR
-          nextAdvanceISR = 0;
-          LA_isr_rate = current_block->advance_speed;
-        }
-        else LA_isr_rate = LA_ADV_NEVER;
+        #if ENABLED(LIN_ADVANCE_UNIFIED)
+          if ((LA_use_advance_lead = current_block->use_advance_lead))
+            LA_advance_scale = current_block->advance_scale;
+        #else
+          if ((LA_use_advance_lead = current_block->use_advance_lead)) {
+            LA_final_adv_steps = current_block->final_adv_steps;
+            LA_max_adv_steps = current_block->max_adv_steps;
+            //Start the ISR
+            nextAdvanceISR = 0;
+            LA_isr_rate = current_block->advance_speed;
+          }
+          else LA_isr_rate = LA_ADV_NEVER;
+        #endif
       #endif
 
       if (
@@ -2036,6 +2076,19 @@ uint32_t Stepper::stepper_block_phase_isr() {
       if (laser_trap.enabled)
         laser->TurnOn_ISR(laser_trap.cur_power, current_block->laser.status.is_sync_power, current_block->laser.sync_power);
 
+      #if ENABLED(LASER_RASTER_MODE)
+        // Set up raster scanline
+        if (current_block->raster_slot != LASER_RASTER_SLOT_NONE) {
+          laser_scan.pwm = laser_raster.pwm(current_block->raster_slot);
+          laser_scan.pixels = laser_raster.pixels(current_block->raster_slot);
+          laser_scan.pixel_rate = ((uint32_t)laser_scan.pixels << 16) / current_block->step_event_count;
+          laser_scan.index = 0;
+          laser->TurnOn_ISR(laser_scan.pwm[0], false, 0);
+        }
+        else
+          laser_scan.pwm = nullptr;
+      #endif
+
       // At this point, we must ensure the movement about to execute isn't
       // trying to force the head against a limit switch. If using interrupt-
       // driven change detection, and already against a limit then no call to
@@ -2078,10 +2131,44 @@ uint32_t Stepper::stepper_block_phase_isr() {
 
 #if ENABLED(LIN_ADVANCE)
 
+  #if ENABLED(LIN_ADVANCE_UNIFIED)
+
+    void Stepper::LA_update(const uint32_t step_rate, const uint32_t interval) {
+      // Retract and travel moves keep the pressure, as the advance ISR does
+      if (!LA_use_advance_lead) return;
+
+      const uint32_t target = MIN((uint64_t(step_rate) * LA_advance_scale) >> 16, uint64_t(UINT16_MAX));
+      if (target == LA_current_adv_steps) return;
+
+      // First order filter, the block phase runs every interval ticks
+      const bool forward = target > LA_current_adv_steps;
+      const uint32_t diff = forward ? target - LA_current_adv_steps : LA_current_adv_steps - target;
+      uint32_t delta = diff * interval / (LA_SMOOTH_TICKS + interval);
+      NOLESS(delta, 1U);
+      NOMORE(delta, uint32_t(LIN_ADVANCE_STEPS_PER_ISR));
+
+      if (forward) {
+        LA_current_adv_steps += delta;
+        LA_steps += delta;
+      }
+      else {
+        LA_current_adv_steps -= delta;
+        LA_steps -= delta;
+      }
+    }
+
+  #endif // LIN_ADVANCE_UNIFIED
+
   // Timer interrupt for E. LA_steps is set in the main routine
   uint32_t Stepper::advance_isr() {
     uint32_t interval;
 
+    LA_isr_count++;
+
+    #if ENABLED(LIN_ADVANCE_UNIFIED)
+      // The advance was already added to LA_steps in the block phase
+      interval = LA_ADV_NEVER;
+    #else
     if (LA_use_advance_lead) {
       if (step_events_completed > decelerate_after && LA_current_adv_steps > LA_final_adv_steps) {
         LA_steps--;
@@ -2099,6 +2186,7 @@ uint32_t Stepper::stepper_block_phase_isr() {
     }
     else
       interval = LA_ADV_NEVER;
+    #endif
 
       #if ENABLED(MIXING_EXTRUDER)
         // We don't know which steppers will be stepped because LA loop follows,
@@ -327,6 +327,9 @@ class Stepper {
       static uint16_t LA_current_adv_steps, LA_final_adv_steps, LA_max_adv_steps; // Copy from current executed block. Needed because current_block is set to NULL "too early".
       static int8_t LA_steps;
       static bool LA_use_advance_lead;
+      #if ENABLED(LIN_ADVANCE_UNIFIED)
+        static uint32_t LA_advance_scale;
+      #endif
     #endif // LIN_ADVANCE
 
     static int32_t ticks_nominal;
@@ -357,6 +360,21 @@ class Stepper {
     } stepper_laser_t;
 
     static stepper_laser_t laser_trap;
+    static uint16_t laser_ramp_power(const uint16_t base, const uint32_t factor, uint32_t step_rate);
+
+    #if ENABLED(LASER_RASTER_MODE)
+      //
+      // Laser Raster Scanline (G7)
+      //
+      typedef struct {
+        const uint8_t *pwm;  // Pixel powers of the current block, nullptr if it is no scanline
+        uint32_t pixel_rate; // Pixels per step event, 16.16 fixed point
+        uint16_t pixels;     // Pixels in the scanline
+        uint16_t index;      // Pixel being burned
+      } stepper_raster_t;
+
+      static stepper_raster_t laser_scan;
+    #endif
 
   public:
 
@@ -386,6 +404,9 @@ class Stepper {
     #if ENABLED(LIN_ADVANCE)
       // The Linear advance stepper ISR
       static uint32_t advance_isr();
+
+      // Counts of advance and main ISR runs for M900, cleared on read
+      static uint32_t LA_isr_count, LA_main_isr_count;
     #endif
 
     // Check if the given block is busy or not - Must not be called from ISR contexts
@@ -397,6 +418,9 @@ class Stepper {
     // Report the positions of the steppers, in steps
     static void report_positions();
 
+    // Step events done in the current block, the stepper ISR may change it
+    FORCE_INLINE static uint32_t block_steps_completed() { return step_events_completed; }
+
     // The stepper subsystem goes to sleep when it runs out of things to execute. Call this
     // to notify the subsystem that it is time to go to work.
     static void wake_up();
@@ -518,6 +542,11 @@ class Stepper {
     static void _set_position(const int32_t &a, const int32_t &b, const int32_t &c, const int32_t &e);
     static void _set_position(const int32_t &x, const int32_t &y, const int32_t &z, const int32_t &b, const int32_t &e);
 
+    #if ENABLED(LIN_ADVANCE_UNIFIED)
+      // Move the advance toward K * E speed, once per block phase
+      static void LA_update(const uint32_t step_rate, const uint32_t interval);
+    #endif
+
     FORCE_INLINE static uint32_t calc_timer_interval(uint32_t step_rate, uint8_t scale, uint8_t* loops) {
       uint32_t timer;
 
@@ -36,6 +36,7 @@
 #if (MOTHERBOARD == BOARD_SNAPMAKER_2_0)
   #include "snapmaker.h"
   #include "../../../snapmaker/src/module/toolhead_laser.h"
+  #include "../../../snapmaker/src/hmi/event_handler.h"
 #endif
 
 #define MAX6675_SEPARATE_SPI EITHER(HEATER_0_USES_MAX6675, HEATER_1_USES_MAX6675) && PIN_EXISTS(MAX6675_SCK, MAX6675_DO)
@@ -400,6 +401,20 @@ void Temperature::getHeaterPID() {
       return;
     }
 
+    #if ENABLED(PIDTEMPBED)
+      // isr() drives the bed only with a 3D printing toolhead, and setTargetBed() is bypassed here
+      if (heater < 0) {
+        if (action_ban & ACTION_BAN_NO_HEATING_BED) {
+          SERIAL_ECHOLNPAIR("PID autotune: bed heating is banned, fault: ", systemservice.GetFaultFlag());
+          return;
+        }
+        if (MODULE_TOOLHEAD_3DP != ModuleBase::toolhead() && MODULE_TOOLHEAD_DUALEXTRUDER != ModuleBase::toolhead()) {
+          SERIAL_ECHOLNPGM("PID autotune: bed needs a 3D printing toolhead");
+          return;
+        }
+      }
+    #endif
+
     SERIAL_ECHOLNPGM(MSG_PID_AUTOTUNE_START);
 
     disable_all_heaters();
@@ -979,7 +994,14 @@ void Temperature::manage_heater() {
       #endif
 
       // check if thermistor is bad
-      if (temp_hotend[e].current < 0 || temp_hotend[e].current > 500) {
+      if (temp_hotend[e].current < 0 || temp_hotend[e].current > 500
+        #if ENABLED(HOTEND_TEMP_TELEMETRY)
+          // or module stopped reporting while heating, current is stale,
+          // not before its first report, e.g. target set right after boot
+          || (temp_hotend[e].target > 0 && printer1->temp_seq(e) != 0
+              && printer1->GetTempAge(e) > HOTEND_TEMP_STALE_TIME)
+        #endif
+      ) {
         if (++hotend_sensor_bad == 3)
           systemservice.ThrowException((ExceptionHost)(e), ETYPE_SENSOR_BAD);
         else if (hotend_sensor_bad > 3) {
@@ -2539,6 +2561,26 @@ public:
   #endif
 };
 
+#if ENABLED(BED_SLOW_PWM)
+  // Time-proportioned window for the bed, soft_pwm_amount 0-127 is the duty
+  class SlowBedPWM {
+  public:
+    millis_t start_ms;
+    uint16_t on_ms;
+    inline bool update(const millis_t ms, const uint8_t amount) {
+      if (!amount)
+        on_ms = 0;
+      else if (ms - start_ms >= BED_PWM_PERIOD) {
+        start_ms = ms;
+        on_ms = uint32_t(BED_PWM_PERIOD) * MIN(amount, 127) / 127;
+        if (on_ms < BED_PWM_MIN_STATE) on_ms = 0;
+        else if (on_ms > BED_PWM_PERIOD - (BED_PWM_MIN_STATE)) on_ms = BED_PWM_PERIOD;
+      }
+      return ms - start_ms < on_ms;
+    }
+  };
+#endif
+
 void Temperature::isr() {
 
   static int8_t temp_count = -1;
@@ -2559,6 +2601,9 @@ void Temperature::isr() {
 
   #if HAS_HEATED_BED
     static SoftPWM soft_pwm_bed;
+    #if ENABLED(BED_SLOW_PWM)
+      static SlowBedPWM slow_pwm_bed;
+    #endif
   #endif
 
   #if HAS_HEATED_CHAMBER
@@ -2578,6 +2623,10 @@ void Temperature::isr() {
      * Standard heater PWM modulation
      */
     if(MODULE_TOOLHEAD_3DP == ModuleBase::toolhead() || MODULE_TOOLHEAD_DUALEXTRUDER == ModuleBase::toolhead()) {
+      #if ENABLED(BED_SLOW_PWM)
+        WRITE_HEATER_BED(slow_pwm_bed.update(millis(), temp_bed.soft_pwm_amount));
+      #endif
+
       if (pwm_count_tmp >= 127) {
         pwm_count_tmp -= 127;
         #define _PWM_MOD(N,S,T) do{                           \
@@ -2602,7 +2651,7 @@ void Temperature::isr() {
           #endif // HOTENDS > 2
         #endif // HOTENDS > 1
 
-        #if HAS_HEATED_BED
+        #if HAS_HEATED_BED && DISABLED(BED_SLOW_PWM)
           _PWM_MOD(BED,soft_pwm_bed,temp_bed);
         #endif
 
@@ -2648,7 +2697,7 @@ void Temperature::isr() {
           #endif // HOTENDS > 1
         #endif // HOTENDS
 
-        #if HAS_HEATED_BED
+        #if HAS_HEATED_BED && DISABLED(BED_SLOW_PWM)
           _PWM_LOW(BED, soft_pwm_bed);
         #endif
 
@@ -3287,6 +3336,9 @@ void Temperature::isr() {
         }
 
         idle();
+        #if ENABLED(EVENT_DRIVEN_HEAT_WAIT)
+          heat_wait_yield();
+        #endif
         gcode.reset_stepper_timeout(); // Keep steppers powered
 
         const float temp = degHotend(target_extruder);
@@ -3430,6 +3482,9 @@ void Temperature::isr() {
         }
 
         idle();
+        #if ENABLED(EVENT_DRIVEN_HEAT_WAIT)
+          heat_wait_yield();
+        #endif
         gcode.reset_stepper_timeout(); // Keep steppers powered
 
         const float temp = degBed();
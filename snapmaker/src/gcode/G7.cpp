@@ -0,0 +1,130 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2023 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../common/config.h"
+#include "../common/debug.h"
+#include "../module/toolhead_laser.h"
+#include "../service/laser_raster.h"
+
+#include "src/gcode/gcode.h"
+#include "src/module/motion.h"
+#include "src/module/planner.h"
+
+#if ENABLED(LASER_RASTER_MODE)
+
+/**
+ * G7: Laser raster scanline
+ *
+ *  L<line>   Line number, must match the line of the pixel data
+ *  N<pixels> Number of pixels, up to LASER_RASTER_MAX_PIXELS
+ *  D<dir>    Scan direction from the current position, 0: +X, 1: -X, 2: +Y, 3: -Y
+ *  R<mm>     Pixel pitch
+ *  F<feed>   Feedrate, as for G1
+ *
+ * Pixel powers come from the HMI as EID_CAMERA_REQ : CAMERA_OPC_LASER_RASTER_DATA
+ * with payload line(2), pixels(2), offset(2) and one byte per pixel, 0 - 255
+ * for 0 - 100% power. Like G1 P, it is mapped through the power table of the
+ * module and capped by its power limit. A line longer than one SSTP packet is
+ * sent in chunks. The host may send the next line while this one is burning.
+ *
+ * The scanline is one planner block. The stepper ISR looks up the power by
+ * step count, so pixels stay in place through acceleration and deceleration;
+ * the host should add overscan with G0 if constant speed is wanted.
+ *
+ * If the data does not arrive in time, or the line runs out of the soft
+ * endstops, the head still moves with laser off, so the positions of following
+ * commands are kept.
+ */
+void GcodeSuite::G7() {
+  if (!laser->IsOnline()) {
+    LOG_E("G7: no laser\n");
+    return;
+  }
+
+  if (ftMotion.cfg.mode) {
+    LOG_E("G7: not supported with FT motion, M493 S0 first\n");
+    return;
+  }
+
+  const uint16_t line = parser.ushortval('L');
+  const uint16_t pixels = parser.ushortval('N');
+  const uint8_t dir = parser.byteval('D');
+  const float pitch = parser.floatval('R');
+
+  if (pixels == 0 || pixels > LASER_RASTER_MAX_PIXELS || dir > 3 || pitch <= 0) {
+    LOG_E("G7: invalid scanline, N: %u, D: %u, R: %.3f\n", pixels, dir, pitch);
+    return;
+  }
+
+  if (parser.linearval('F') > 0)
+    feedrate_mm_s = MMM_TO_MMS(parser.value_feedrate());
+
+  const AxisEnum axis = dir < 2 ? X_AXIS : Y_AXIS;
+  COPY(destination, current_position);
+  destination[axis] += (TEST(dir, 0) ? -pitch : pitch) * pixels;
+
+  const float unclamped = destination[axis];
+  apply_motion_limits(destination);
+
+  uint8_t slot = laser_raster.TakeLine(line, pixels);
+
+  // a shortened line would squeeze the pixels, so don't burn it at all
+  if (slot != LASER_RASTER_SLOT_NONE && destination[axis] != unclamped) {
+    LOG_E("G7: line %u is out of soft endstops, laser off\n", line);
+    laser_raster.Release(slot);
+    slot = LASER_RASTER_SLOT_NONE;
+  }
+
+  const laser_state_t saved_laser = planner.laser_inline;
+
+  if (slot != LASER_RASTER_SLOT_NONE) {
+    uint8_t *pwm = laser_raster.pwm(slot);
+    uint8_t max_pwm = 0;
+
+    for (uint16_t i = 0; i < pixels; i++) {
+      pwm[i] = laser->PowerConversionPwm(pwm[i] * 100.0f / 255);
+      NOLESS(max_pwm, pwm[i]);
+    }
+
+    // enable laser module and its fan as a G1 would do with the line power
+    laser->PrepareInline(max_pwm);
+    planner.raster_slot = slot;
+  }
+  else {
+    planner.laser_inline.status.isEnabled = false;
+  }
+
+  const uint8_t head = planner.block_buffer_head;
+
+  // one block for the whole line, segmented moves would break the pixel indexing
+  planner.buffer_line(destination, MMS_SCALED(feedrate_mm_s), active_extruder);
+
+  // line was too short to make a block, nobody else will free the slot
+  if (slot != LASER_RASTER_SLOT_NONE && planner.block_buffer_head == head)
+    laser_raster.Release(slot);
+
+  planner.raster_slot = LASER_RASTER_SLOT_NONE;
+  planner.laser_inline = saved_laser;
+
+  set_current_from_destination();
+}
+
+#endif // ENABLED(LASER_RASTER_MODE)
@@ -0,0 +1,50 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(MOVE_COALESCING)
+
+// marlin headers
+#include "src/gcode/gcode.h"
+#include "src/module/move_coalescer.h"
+
+/*
+* Collinear move coalescing
+* S0: disable, S1: enable
+* C: chordal tolerance in mm
+* A: angular tolerance in degrees
+* Without parameters, report the current settings
+*/
+
+
+void GcodeSuite::M1030() {
+  if (parser.seen('S')) coalescer.enabled = parser.value_bool();
+  if (parser.seenval('C')) coalescer.chordal_tolerance = constrain(parser.value_linear_units(), 0, 1);
+  if (parser.seenval('A')) coalescer.set_angular_tolerance(constrain(parser.value_float(), 0, 10));
+
+  SERIAL_ECHOLNPAIR("Move coalescing: ", coalescer.enabled ? "On" : "Off",
+                    " C", coalescer.chordal_tolerance,
+                    " A", coalescer.angular_tolerance(),
+                    " merged: ", coalescer.merged_count());
+}
+
+#endif // MOVE_COALESCING
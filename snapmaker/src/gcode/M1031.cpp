@@ -0,0 +1,53 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(IDLE_NOZZLE_PREHEAT)
+
+#include "../service/idle_nozzle_preheat.h"
+
+// marlin headers
+#include "src/gcode/gcode.h"
+
+/*
+* Idle nozzle standby and preheat
+* S0: disable, S1: enable, default IDLE_NOZZLE_PREHEAT_ENABLED
+* D: standby temperature below the print temperature, in °C
+* R: expected heating rate of a nozzle, in °C/s
+* M: start heating this much earlier, in seconds
+* Without parameters, report the current settings
+*/
+
+
+void GcodeSuite::M1031() {
+  if (parser.seen('S')) nozzle_preheat.enable(parser.value_bool());
+  if (parser.seenval('D')) nozzle_preheat.standby_drop = constrain(parser.value_int(), 0, 100);
+  if (parser.seenval('R')) nozzle_preheat.heat_rate = constrain(parser.value_float(), 0.1f, 20);
+  if (parser.seenval('M')) nozzle_preheat.margin = constrain(parser.value_float(), 0, 60);
+
+  SERIAL_ECHOLNPAIR("Idle nozzle preheat: ", nozzle_preheat.enabled() ? "On" : "Off",
+                    " D", nozzle_preheat.standby_drop,
+                    " R", nozzle_preheat.heat_rate,
+                    " M", nozzle_preheat.margin);
+}
+
+#endif // IDLE_NOZZLE_PREHEAT
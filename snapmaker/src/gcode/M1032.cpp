@@ -0,0 +1,59 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+
+#include "../service/temp_telemetry.h"
+#include "../module/toolhead_3dp.h"
+
+// marlin headers
+#include "src/gcode/gcode.h"
+
+/*
+* Hotend temperature telemetry
+* S: stream samples to serial every S ms, 0 to stop
+* R: ask module to report temperature every R ms
+* Always report age, interval and slope of the samples of each hotend
+*/
+
+
+void GcodeSuite::M1032() {
+  if (parser.seenval('S')) temp_telemetry.serial_interval(parser.value_ushort());
+
+  if (parser.seenval('R')) {
+    if (printer1->SetTempReportInterval(constrain(parser.value_ushort(), 10, 5000)) != E_SUCCESS)
+      SERIAL_ECHOLN("module doesn't support setting report interval");
+  }
+
+  SERIAL_ECHOLNPAIR("Temp telemetry: S", temp_telemetry.serial_interval());
+
+  for (uint8_t e = 0; e < temp_telemetry.hotends(); e++) {
+    SERIAL_ECHOLNPAIR(" T", e, ": ", printer1->GetTemp(e) / 10.0f,
+                      " age: ", printer1->GetTempAge(e),
+                      " interval: ", temp_telemetry.SampleInterval(e),
+                      " rate: ", temp_telemetry.SampleRate(e) / 10.0f,
+                      " samples: ", printer1->temp_seq(e));
+  }
+}
+
+#endif // HOTEND_TEMP_TELEMETRY
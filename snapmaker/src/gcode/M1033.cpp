@@ -0,0 +1,62 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(VOLUMETRIC_FLOW_LIMIT)
+
+// marlin headers
+#include "src/gcode/gcode.h"
+#include "src/module/planner.h"
+
+/*
+* Volumetric flow limit
+* E: extruder, all extruders if omitted
+* S: max flow in mm³/s, 0 for no limit
+* Always report the limit of each extruder
+*/
+
+
+void GcodeSuite::M1033() {
+  if (parser.seenval('S')) {
+    const float flow = MAX(parser.value_float(), 0);
+
+    if (parser.seenval('E')) {
+      const uint8_t e = parser.value_byte();
+      if (e >= EXTRUDERS) {
+        SERIAL_ECHOLNPAIR("invalid extruder: ", e);
+        return;
+      }
+      planner.set_volumetric_extruder_limit(e, flow);
+    }
+    else {
+      for (uint8_t e = 0; e < EXTRUDERS; e++)
+        planner.set_volumetric_extruder_limit(e, flow);
+    }
+  }
+
+  SERIAL_ECHOPGM("Max volumetric flow:");
+  for (uint8_t e = 0; e < EXTRUDERS; e++)
+    SERIAL_ECHOPAIR(" E", e, ": ", planner.volumetric_extruder_limit[e]);
+  SERIAL_EOL();
+}
+
+#endif // VOLUMETRIC_FLOW_LIMIT
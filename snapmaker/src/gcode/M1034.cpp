@@ -0,0 +1,100 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(NOZZLE_MOTION_PROFILE)
+
+#include "../service/nozzle_profile.h"
+
+// marlin headers
+#include "src/gcode/gcode.h"
+#include "src/module/planner.h"
+
+/*
+* Nozzle motion profile
+* I: nozzle type, index of hotend_info, required to set
+* P: print acceleration
+* T: travel acceleration
+* R: retract acceleration
+* A: X shaping frequency
+* B: Y shaping frequency
+* K: linear advance K, -1 to keep
+* F: max volumetric flow
+* C: clear the profile
+* Fields not given are unchanged, 0 keeps the current value when applied.
+* Always report the profiles which are set and the nozzle types detected.
+* M500 to save.
+*/
+
+
+void GcodeSuite::M1034() {
+  if (parser.seenval('I')) {
+    const uint8_t i = parser.value_byte();
+    if (i >= HOTEND_INFO_MAX || hotend_info[i].model == INVALID_HOTEND_TYPE) {
+      SERIAL_ECHOLNPAIR("invalid nozzle type: ", i);
+      return;
+    }
+
+    nozzle_profile_t &p = nozzle_profile.profile[i];
+
+    if (parser.seen('C')) {
+      p.acceleration = p.travel_acceleration = p.retract_acceleration = 0;
+      p.shaping_freq[0] = p.shaping_freq[1] = 0;
+      p.advance_K = -1;
+      p.max_flow = 0;
+    }
+
+    if (parser.seenval('P')) p.acceleration = MAX(parser.value_float(), 0);
+    if (parser.seenval('T')) p.travel_acceleration = MAX(parser.value_float(), 0);
+    if (parser.seenval('R')) p.retract_acceleration = MAX(parser.value_float(), 0);
+    if (parser.seenval('A')) p.shaping_freq[0] = MAX(parser.value_float(), 0);
+    if (parser.seenval('B')) p.shaping_freq[1] = MAX(parser.value_float(), 0);
+    if (parser.seenval('K')) p.advance_K = MAX(parser.value_float(), -1);
+    if (parser.seenval('F')) p.max_flow = MAX(parser.value_float(), 0);
+
+    // takes effect at once if the nozzle is in use
+    for (uint8_t e = 0; e < EXTRUDERS; e++) {
+      if (nozzle_profile.type(e) == i) {
+        planner.synchronize();
+        nozzle_profile.Apply();
+        break;
+      }
+    }
+  }
+
+  for (uint8_t i = 0; i < HOTEND_INFO_MAX; i++) {
+    const nozzle_profile_t &p = nozzle_profile.profile[i];
+    if (hotend_info[i].model == INVALID_HOTEND_TYPE)
+      continue;
+
+    SERIAL_ECHOPAIR("M1034 I", i, " P", p.acceleration, " T", p.travel_acceleration, " R", p.retract_acceleration);
+    SERIAL_ECHOPAIR(" A", p.shaping_freq[0], " B", p.shaping_freq[1], " K", p.advance_K, " F", p.max_flow);
+    SERIAL_ECHOLNPAIR(" ; ", hotend_info[i].diameter, " mm");
+  }
+
+  SERIAL_ECHOPGM("Nozzle types:");
+  for (uint8_t e = 0; e < EXTRUDERS; e++)
+    SERIAL_ECHOPAIR(" E", e, ": ", nozzle_profile.type(e));
+  SERIAL_EOL();
+}
+
+#endif // NOZZLE_MOTION_PROFILE
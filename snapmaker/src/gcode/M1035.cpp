@@ -0,0 +1,86 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(LEVELING_MESH_SLOTS)
+
+#include "../service/mesh_slot.h"
+#include "../module/module_base.h"
+
+// marlin headers
+#include "src/gcode/gcode.h"
+#include "src/module/planner.h"
+
+/*
+* Leveling mesh slots
+* B: bed id, load the mesh of current toolhead on this bed
+* D: host time in seconds, to stamp the meshes stored after it
+* S: store the mesh in use into the slot of current toolhead and bed
+* L: load the mesh in slot, it must be probed with current toolhead
+* C: clear the slot
+* The mesh is stored on each save after leveling, and loaded when toolhead
+* or bed is changed. Always report the slots.
+* M500 to save.
+*/
+
+
+void GcodeSuite::M1035() {
+  if (parser.seenval('D'))
+    mesh_slot.SetTime(parser.value_ulong());
+
+  if (parser.seenval('C'))
+    mesh_slot.Clear(parser.value_byte());
+
+  if (parser.seenval('B')) {
+    planner.synchronize();
+    mesh_slot.Select(ModuleBase::toolhead(), parser.value_byte());
+  }
+
+  if (parser.seen('S'))
+    mesh_slot.Capture();
+
+  if (parser.seenval('L')) {
+    const uint8_t i = parser.value_byte();
+    if (i >= MESH_SLOT_NUM || mesh_slot.slot[i].toolhead != ModuleBase::toolhead()) {
+      SERIAL_ECHOLNPAIR("no mesh of current toolhead in slot: ", i);
+    }
+    else {
+      planner.synchronize();
+      mesh_slot.Load(i);
+    }
+  }
+
+  for (uint8_t i = 0; i < MESH_SLOT_NUM; i++) {
+    const mesh_slot_t &m = mesh_slot.slot[i];
+    if (m.toolhead == MODULE_TOOLHEAD_UNKNOW)
+      continue;
+
+    SERIAL_ECHOPAIR("Slot ", i, ": toolhead ", m.toolhead, ", bed ", m.bed, ", grid ", m.grid_x, "x", m.grid_y);
+    SERIAL_ECHOPAIR(", bed temp ", m.bed_temp, ", time ", m.timestamp);
+    if (i == mesh_slot.active()) SERIAL_ECHOPGM(" *");
+    SERIAL_EOL();
+  }
+
+  SERIAL_ECHOLNPAIR("Bed: ", mesh_slot.bed(), ", mesh valid: ", MeshSlot::MeshValid());
+}
+
+#endif // LEVELING_MESH_SLOTS
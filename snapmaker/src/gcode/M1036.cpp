@@ -0,0 +1,82 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(BED_THERMAL_DRIFT)
+
+#include "../service/thermal_drift.h"
+#include "../service/bed_level.h"
+
+// marlin headers
+#include "src/gcode/gcode.h"
+#include "src/module/temperature.h"
+
+/*
+* Bed thermal drift
+* P: probe the drift points at current bed temperature, heat the bed and
+*    wait it to settle before, e.g. M190. Do it at two or more temperatures.
+* R: bed temperature the mesh in use was probed at, it is taken when a new
+*    mesh is saved
+* S: 1 to move the mesh with bed temperature, 0 to not
+* C: clear the samples
+* Always report the samples and the model.
+* M500 to save.
+*/
+
+
+void GcodeSuite::M1036() {
+  if (parser.seen('C')) {
+    thermal_drift.cfg.samples = 0;
+    thermal_drift.Fit();
+  }
+
+  if (parser.seenval('S'))
+    thermal_drift.cfg.enabled = parser.value_bool();
+
+  if (parser.seenval('R'))
+    thermal_drift.SetMeshTemp(parser.value_float());
+
+  if (parser.seen('P')) {
+    if (levelservice.ProbeThermalDrift() != E_SUCCESS)
+      SERIAL_ECHOLNPGM("thermal drift probing failed");
+  }
+
+  for (uint8_t i = 0; i < thermal_drift.cfg.samples; i++) {
+    SERIAL_ECHOPAIR("Sample ", i, " at ", thermal_drift.cfg.temp[i], ":");
+    for (uint8_t k = 0; k < THERMAL_DRIFT_POINTS; k++)
+      SERIAL_ECHOPAIR_F(" ", thermal_drift.cfg.z[i][k], 3);
+    SERIAL_EOL();
+  }
+
+  if (thermal_drift.fitted()) {
+    SERIAL_ECHOPAIR_F("Drift mm/C: ", thermal_drift.slope(0), 5);
+    SERIAL_ECHOPAIR_F(" X: ", thermal_drift.slope(1), 7);
+    SERIAL_ECHOLNPAIR_F(" Y: ", thermal_drift.slope(2), 7);
+  }
+  else {
+    SERIAL_ECHOLNPGM("Drift not fitted, need two temperatures 5C apart");
+  }
+
+  SERIAL_ECHOLNPAIR("Mesh temp: ", thermal_drift.cfg.mesh_temp, ", bed: ", thermalManager.degBed(), ", enabled: ", thermal_drift.cfg.enabled);
+}
+
+#endif // BED_THERMAL_DRIFT
@@ -0,0 +1,158 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(PROBE_SPEED_TUNING)
+
+#include "../module/module_base.h"
+
+// marlin headers
+#include "src/gcode/gcode.h"
+#include "src/module/motion.h"
+#include "src/module/planner.h"
+#include "src/module/probe.h"
+
+#define PROBE_TUNING_MAX_SPEEDS 6
+
+/*
+* Probe speed tuning
+* X, Y: probe position, default the current position as M48
+* S: slowest speed to test in mm/min, default 60
+* F: fastest speed to test in mm/min, default Z_PROBE_SPEED_FAST
+* N: number of speeds from S to F, 2 - 6, default 4
+* P: probes at each speed, default PROBE_TUNING_SAMPLES
+* T: repeatability target in mm, standard deviation, default PROBE_TUNING_SIGMA
+* A: apply the recommended speeds
+* R: reset the speeds to default
+* Without S, F, N, P, T or A, only report the speeds in use. M500 to save.
+*
+* The stop height falls with the speed by latency * speed. The latency is
+* fitted over all stops, its intercept is where the probe really triggers.
+* Slow speed is the fastest one within the target, and whose latest stop
+* is still below the raise before the slow probe. Fast speed only has to
+* stop within the raise after a fast approach.
+*/
+void GcodeSuite::M1037() {
+  // only the 3DP heads have the probe
+  if (MODULE_TOOLHEAD_3DP != ModuleBase::toolhead() && MODULE_TOOLHEAD_DUALEXTRUDER != ModuleBase::toolhead()) {
+    SERIAL_ECHOLNPGM("?probe speed tuning: only with 3DP");
+    return;
+  }
+
+  if (parser.seen('R')) {
+    z_probe_speed_fast = Z_PROBE_SPEED_FAST;
+    z_probe_speed_slow = Z_PROBE_SPEED_SLOW;
+  }
+
+  if (parser.seen("SFNPTA")) {
+    if (axis_unhomed_error()) return;
+
+    const float min_speed = parser.floatval('S', 60),
+                max_speed = parser.floatval('F', Z_PROBE_SPEED_FAST),
+                target = parser.floatval('T', PROBE_TUNING_SIGMA);
+    const uint8_t speeds = parser.byteval('N', 4),
+                  probes = parser.byteval('P', PROBE_TUNING_SAMPLES);
+
+    if (!WITHIN(speeds, 2, PROBE_TUNING_MAX_SPEEDS) || !WITHIN(probes, 2, 10) || min_speed <= 0 || max_speed <= min_speed) {
+      SERIAL_ECHOLNPGM("?invalid speeds or probes");
+      return;
+    }
+
+    const float rx = parser.linearval('X', current_position[X_AXIS] + X_PROBE_OFFSET_FROM_EXTRUDER),
+                ry = parser.linearval('Y', current_position[Y_AXIS] + Y_PROBE_OFFSET_FROM_EXTRUDER);
+
+    // find the bed, Z is left at the trigger height
+    if (isnan(probe_pt(rx, ry, PROBE_PT_NONE))) return;
+
+    float speed[PROBE_TUNING_MAX_SPEEDS], sigma[PROBE_TUNING_MAX_SPEEDS], lowest[PROBE_TUNING_MAX_SPEEDS];
+    float z[10];
+    float sx = 0, sy = 0, sxx = 0, sxy = 0;
+    const uint16_t count = speeds * probes;
+    const float accel = planner.settings.max_acceleration_mm_per_s2[Z_AXIS];
+
+    for (uint8_t i = 0; i < speeds; i++) {
+      speed[i] = min_speed * POW(max_speed / min_speed, float(i) / (speeds - 1));
+      const float v = MMM_TO_MMS(speed[i]);
+
+      // start high enough to reach the speed before the trigger
+      if (!probe_stops(v, Z_CLEARANCE_MULTI_PROBE + sq(v) / (2 * accel), z, probes)) {
+        STOW_PROBE();
+        return;
+      }
+
+      float sum = 0, sum2 = 0;
+      lowest[i] = z[0];
+      for (uint8_t k = 0; k < probes; k++) {
+        sum += z[k];
+        sum2 += sq(z[k]);
+        NOMORE(lowest[i], z[k]);
+        sx += v; sy += z[k]; sxx += sq(v); sxy += v * z[k];
+      }
+      sigma[i] = SQRT(MAX(0.0f, (sum2 - sq(sum) / probes) / (probes - 1)));
+
+      SERIAL_ECHOPAIR("Speed ", int(speed[i]));
+      SERIAL_ECHOPAIR_F(" mean: ", sum / probes, 4);
+      SERIAL_ECHOPAIR_F(" sigma: ", sigma[i], 4);
+      SERIAL_ECHOLNPAIR_F(" lowest: ", lowest[i], 4);
+    }
+
+    do_blocking_move_to_z(current_position[Z_AXIS] + Z_CLEARANCE_BETWEEN_PROBES, MMM_TO_MMS(Z_PROBE_SPEED_FAST));
+    STOW_PROBE();
+
+    // stop = trigger - latency * speed
+    const float slope = (count * sxy - sx * sy) / (count * sxx - sq(sx)),
+                trigger = (sy - slope * sx) / count;
+
+    SERIAL_ECHOPAIR_F("Latency ms: ", -slope * 1000, 2);
+    SERIAL_ECHOLNPAIR_F(" trigger: ", trigger, 4);
+
+    #if ENABLED(QUICK_AUTO_PROBING)
+      const float recheck = QUICK_PROBING_RECHECK;
+    #else
+      const float recheck = Z_CLEARANCE_MULTI_PROBE;
+    #endif
+
+    // half of the raise is kept as margin
+    float slow = 0, fast = 0;
+    for (uint8_t i = 0; i < speeds; i++) {
+      const float overshoot = trigger - lowest[i];
+      if (sigma[i] <= target && overshoot <= recheck / 2) slow = speed[i];
+      if (overshoot <= Z_CLEARANCE_BETWEEN_PROBES / 2.0f) fast = speed[i];
+    }
+
+    if (slow == 0) {
+      SERIAL_ECHOLNPGM("No speed meets the target");
+    }
+    else {
+      NOLESS(fast, slow);
+      SERIAL_ECHOLNPAIR("Recommended fast: ", int(fast), " slow: ", int(slow));
+      if (parser.seen('A')) {
+        z_probe_speed_fast = fast;
+        z_probe_speed_slow = slow;
+      }
+    }
+  }
+
+  SERIAL_ECHOLNPAIR("Probe speed fast: ", int(z_probe_speed_fast), " slow: ", int(z_probe_speed_slow));
+}
+
+#endif // PROBE_SPEED_TUNING
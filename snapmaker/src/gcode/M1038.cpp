@@ -0,0 +1,58 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(INCREMENTAL_LEVELING)
+
+#include "../service/bed_level.h"
+
+// marlin headers
+#include "src/gcode/gcode.h"
+#include "src/feature/bedlevel/abl/abl.h"
+
+/*
+* Incremental leveling, for 3DP with a mesh from auto leveling
+* N: probe every Nth point, and the last one, of each row and column,
+*    default INCREMENTAL_LEVELING_STEP
+* T: re-probe the cells around a point which moved more than this (mm),
+*    default INCREMENTAL_LEVELING_THRESHOLD
+* Points not probed move with the corners of their cell. The mesh is saved
+* when done, and is left as it was if any probe failed.
+*/
+void GcodeSuite::M1038() {
+  const uint8_t step = parser.byteval('N', INCREMENTAL_LEVELING_STEP);
+  const float threshold = parser.floatval('T', INCREMENTAL_LEVELING_THRESHOLD);
+
+  if (step < 1 || threshold <= 0) {
+    SERIAL_ECHOLNPGM("?invalid step or threshold");
+    return;
+  }
+
+  if (levelservice.IncrementalLeveling(threshold, step) != E_SUCCESS) {
+    SERIAL_ECHOLNPGM("incremental leveling failed");
+    return;
+  }
+
+  print_bilinear_leveling_grid();
+}
+
+#endif // INCREMENTAL_LEVELING
@@ -0,0 +1,85 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(JOB_ALIGNMENT)
+
+#include "../service/job_align.h"
+#include "../module/module_base.h"
+
+// marlin headers
+#include "src/gcode/gcode.h"
+
+/*
+* Camera calibration, for job alignment with M1040
+* A B C D E F: camera pixel (u, v) to machine XY, relative to the head when
+*    the image is taken: x = A * u + B * v + C, y = D * u + E * v + F.
+*    All six are needed.
+* R: forget the calibration
+* Always report the calibration and the cached crosslight offset.
+* M500 to save, the crosslight offset is cached in RAM when read from the
+*    laser module and saved with them.
+*/
+void GcodeSuite::M1039() {
+  static const char coef[6] = { 'A', 'B', 'C', 'D', 'E', 'F' };
+  float camera[6];
+  uint8_t seen = 0;
+
+  if (parser.seen('R'))
+    job_align.cfg.camera_valid = false;
+
+  for (uint8_t i = 0; i < 6; i++) {
+    if (parser.seenval(coef[i])) {
+      camera[i] = parser.value_float();
+      seen++;
+    }
+  }
+
+  if (seen == 6) {
+    COPY(job_align.cfg.camera, camera);
+    job_align.cfg.camera_valid = true;
+  }
+  else if (seen) {
+    SERIAL_ECHOLNPGM("?need all of A B C D E F");
+  }
+
+  if (job_align.cfg.camera_valid) {
+    SERIAL_ECHOPGM("Camera:");
+    for (uint8_t i = 0; i < 6; i++)
+      SERIAL_ECHOPAIR_F(" ", job_align.cfg.camera[i], 6);
+    SERIAL_EOL();
+  }
+  else {
+    SERIAL_ECHOLNPGM("Camera not calibrated");
+  }
+
+  if (job_align.cfg.crosslight_mac != MODULE_MAC_ID_INVALID) {
+    SERIAL_ECHOPAIR("Crosslight offset of module ", job_align.cfg.crosslight_mac);
+    SERIAL_ECHOPAIR_F(", X: ", job_align.cfg.crosslight[X_AXIS], 3);
+    SERIAL_ECHOLNPAIR_F(" Y: ", job_align.cfg.crosslight[Y_AXIS], 3);
+  }
+  else {
+    SERIAL_ECHOLNPGM("No crosslight offset cached");
+  }
+}
+
+#endif // JOB_ALIGNMENT
@@ -0,0 +1,100 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(JOB_ALIGNMENT)
+
+#include "../service/job_align.h"
+
+// marlin headers
+#include "src/gcode/gcode.h"
+#include "src/module/motion.h"
+#include "src/module/planner.h"
+
+/*
+* Job alignment, XY of the moves after it are rotated and moved to fit the
+* workpiece on the bed
+* R X Y I J: rotate R degrees about X Y, then move by I J, all in machine
+*    coordinates (mm)
+* P<k> X Y U V: reference mark k of the job is at X Y, as given to G1. It is
+*    found at camera pixel U V of the image taken at the current position,
+*    see M1039, or under the laser spot if no U V. P0 moves the job onto its
+*    mark, P1 then turns the job about P0.
+* C: clear the alignment
+* Always report the alignment.
+* Moves are clamped to the machine travel after the transform, so parts of a
+*    job turned or moved off the bed are cut short there.
+* G28 keeps it, power loss recovery doesn't.
+*/
+void GcodeSuite::M1040() {
+  if (parser.seen('C')) {
+    job_align.Clear();
+  }
+  else if (parser.seenval('P')) {
+    const uint8_t k = parser.value_byte();
+
+    if (k >= JOB_ALIGN_MARKS || !parser.seenval('X') || !parser.seenval('Y')) {
+      SERIAL_ECHOLNPGM("?need P0 or P1 with X Y");
+      return;
+    }
+
+    if (axis_unhomed_error(true, true, false)) return;
+
+    const float x = LOGICAL_TO_NATIVE(parser.floatval('X'), X_AXIS),
+                y = LOGICAL_TO_NATIVE(parser.floatval('Y'), Y_AXIS);
+    float mx, my;
+
+    if (parser.seen('U') || parser.seen('V')) {
+      if (!job_align.CameraToMachine(parser.floatval('U'), parser.floatval('V'), mx, my)) {
+        SERIAL_ECHOLNPGM("?camera not calibrated, see M1039");
+        return;
+      }
+    }
+    else {
+      mx = current_position[X_AXIS];
+      my = current_position[Y_AXIS];
+      planner.align(mx, my);
+    }
+
+    if (job_align.SetMark(k, x, y, mx, my) != E_SUCCESS) {
+      SERIAL_ECHOLNPGM("?bad reference mark");
+      return;
+    }
+  }
+  else if (parser.seenval('R')) {
+    job_align.Set(parser.value_float(), parser.floatval('X'), parser.floatval('Y'),
+                  parser.floatval('I'), parser.floatval('J'));
+  }
+
+  if (job_align.enabled()) {
+    SERIAL_ECHOPAIR_F("Job aligned: R", job_align.angle(), 4);
+    SERIAL_ECHOPAIR_F(" X", job_align.center(X_AXIS), 3);
+    SERIAL_ECHOPAIR_F(" Y", job_align.center(Y_AXIS), 3);
+    SERIAL_ECHOPAIR_F(" I", job_align.offset(X_AXIS), 3);
+    SERIAL_ECHOLNPAIR_F(" J", job_align.offset(Y_AXIS), 3);
+  }
+  else {
+    SERIAL_ECHOLNPGM("Job not aligned");
+  }
+}
+
+#endif // JOB_ALIGNMENT
@@ -38,6 +38,11 @@
  *
  *  S0 turns off spindle.
  *
+ *  For the laser, M3 keeps the power constant along each move while M4 scales
+ *  it with the actual velocity through acceleration and deceleration, so
+ *  corners and short moves are not over-burned. The stepper ISR follows the
+ *  ramp precomputed per block by the planner (see laser_ramp_t).
+ *
  *  If no speed PWM output is defined then M3/M4 just turns it on.
  *
  *  At least 12.8KHz (50Hz * 256) is needed for spindle PWM.
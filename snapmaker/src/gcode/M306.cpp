@@ -0,0 +1,73 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(HOTEND_FEEDFORWARD)
+
+#include "../service/hotend_feedforward.h"
+
+// marlin headers
+#include "src/gcode/gcode.h"
+#include "src/module/motion.h"
+
+/*
+* Hotend thermal model for feed-forward
+* E: hotend, default the active one
+* T: calibrate H and R of the active hotend, S: target, default 200
+* P: heater power in W
+* H: filament volumetric heat capacity in J/K/mm³
+* R: filament temperature before melting, °C
+* F: feed-forward, 0: off, 1: on
+* Always report the model and the current feed-forward power.
+* M500 to save.
+*/
+
+
+void GcodeSuite::M306() {
+  const uint8_t e = parser.byteval('E', active_extruder);
+  if (e >= EXTRUDERS) {
+    SERIAL_ECHOLN("invalid hotend");
+    return;
+  }
+
+  HotendModel_t &m = hotend_ff.model[e];
+
+  if (parser.seen('F')) hotend_ff.enable(parser.value_bool());
+  if (parser.seenval('P')) m.heater_power = constrain(parser.value_float(), 1, 200);
+  if (parser.seenval('H')) m.filament_heat_cap = constrain(parser.value_float(), 0, 0.01f);
+  if (parser.seenval('R')) m.ambient = constrain(parser.value_float(), 0, 50);
+
+  if (parser.seen('T')) {
+    if (e != active_extruder) {
+      SERIAL_ECHOLN("only the active hotend can extrude for calibration");
+      return;
+    }
+    hotend_ff.Calibrate(parser.intval('S', 200));
+    return;
+  }
+
+  SERIAL_ECHOLNPAIR("M306 E", e, " P", m.heater_power, " H", m.filament_heat_cap,
+                    " R", m.ambient, " F", hotend_ff.enabled(),
+                    " flow: ", hotend_ff.flow(e), " power: ", hotend_ff.power(e));
+}
+
+#endif // HOTEND_FEEDFORWARD
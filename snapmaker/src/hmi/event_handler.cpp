@@ -19,6 +19,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "event_handler.h"
+#include "../snapmaker.h"
 
 #include "../common/debug.h"
 
@@ -34,6 +35,8 @@
 #include "../service/bed_level.h"
 #include "../service/upgrade.h"
 #include "../service/system.h"
+#include "../service/laser_raster.h"
+#include "../service/temp_telemetry.h"
 
 // marlin headers
 #include "src/Marlin.h"
@@ -45,6 +48,7 @@
 #include "src/gcode/gcode.h"
 #include "src/gcode/queue.h"
 #include "src/module/configuration_store.h"
+#include "src/module/move_coalescer.h"
 
 
 #define EVENT_ATTR_HAVE_MOTION  0x1
@@ -313,6 +317,22 @@ void check_and_request_gcode_again() {
   }
 }
 
+/**
+ * Called in Marlin task by M109/M190 while they wait: keep filling the
+ * command queue behind the heating command, so motion resumes with a full
+ * queue, then sleep till next temperature instead of spinning on idle().
+ * Commands are only fetched, they still run in order after the wait.
+ */
+void heat_wait_yield() {
+#if ENABLED(EVENT_DRIVEN_HEAT_WAIT)
+  enqueue_hmi_to_marlin();
+  if (commands_in_queue < BUFSIZE) get_available_commands();
+
+  xEventGroupWaitBits(sm2_handle->event_group, EVENT_GROUP_TEMP_UPDATED, pdTRUE, pdFALSE,
+                      pdMS_TO_TICKS(HEAT_WAIT_YIELD_MS));
+#endif
+}
+
 static ErrCode HandleGcode(uint8_t *event_buff, uint16_t size) {
   event_buff[size] = 0;
   Screen_enqueue_and_echo_commands((char *)(event_buff + 5), INVALID_CMD_LINE, EID_GCODE_ACK);
@@ -543,6 +563,17 @@ static ErrCode GetHotendTemp(SSTP_Event_t &event) {
   return printer1->HmiGetHotendTemp(event);
 }
 
+static ErrCode SetTempReport(SSTP_Event_t &event) {
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+  return temp_telemetry.HmiSetReport(event);
+#else
+  ErrCode err = E_INVALID_CMD;
+  event.data   = &err;
+  event.length = 1;
+  return hmi.Send(event);
+#endif
+}
+
 EventCallback_t sysctl_event_cb[SYSCTL_OPC_MAX] = {
   UNDEFINED_CALLBACK,
   /* [SYSCTL_OPC_GET_STATUES]         = */{EVENT_ATTR_DEFAULT,      SendStatus},
@@ -566,6 +597,8 @@ EventCallback_t sysctl_event_cb[SYSCTL_OPC_MAX] = {
   /* [SYSCTL_OPC_GET_HOTEND_TYPE]     = */{EVENT_ATTR_DEFAULT,      GetHotendType},
   /* [SYSCTL_OPC_GET_FILAMENT_STATE]  = */{EVENT_ATTR_DEFAULT,      GetFilamentState},
   /* [SYSCTL_OPC_GET_HOTEND_TEMP]     = */{EVENT_ATTR_DEFAULT,      GetHotendTemp},
+  /* [SYSCTL_OPC_SET_TEMP_REPORT]     = */{EVENT_ATTR_DEFAULT,      SetTempReport},
+  UNDEFINED_CALLBACK,
 };
 
 
@@ -1115,6 +1148,17 @@ static ErrCode GetCameraBtMAC(SSTP_Event_t &event) {
   return laser->GetCameraBtMAC(event);
 }
 
+static ErrCode ReceiveLaserRasterData(SSTP_Event_t &event) {
+#if ENABLED(LASER_RASTER_MODE)
+  return laser_raster.ReceiveData(event);
+#else
+  ErrCode err = E_INVALID_CMD;
+  event.data   = &err;
+  event.length = 1;
+  return hmi.Send(event);
+#endif
+}
+
 EventCallback_t camera_event_cb[CAMERA_OPC_MAX] = {
   UNDEFINED_CALLBACK,
   UNDEFINED_CALLBACK,
@@ -1123,7 +1167,8 @@ EventCallback_t camera_event_cb[CAMERA_OPC_MAX] = {
   UNDEFINED_CALLBACK,
   /* [CAMERA_OPC_SET_BT_NAME]          =  */{EVENT_ATTR_DEFAULT,  SetCameraBtName},
   /* [CAMERA_OPC_READ_BT_NAME]         =  */{EVENT_ATTR_DEFAULT,  GetCameraBtName},
-  /* [CAMERA_OPC_READ_BT_MAC]          =  */{EVENT_ATTR_DEFAULT,  GetCameraBtMAC}
+  /* [CAMERA_OPC_READ_BT_MAC]          =  */{EVENT_ATTR_DEFAULT,  GetCameraBtMAC},
+  /* [CAMERA_OPC_LASER_RASTER_DATA]    =  */{EVENT_ATTR_DEFAULT,  ReceiveLaserRasterData}
 };
 
 
@@ -1483,6 +1528,13 @@ ErrCode DispatchEvent(DispatcherParam_t param) {
 
   event.length = param->size - 2;
   event.data = param->event_buff + 2;
+
+#if ENABLED(MOVE_COALESCING)
+  // callbacks running in Marlin task may move axes or read planner state
+  if (param->owner == TASK_OWN_MARLIN)
+    coalescer.flush();
+#endif
+
   return callbacks[event.op_code].cb(event);
 
 out_err:
@@ -64,6 +64,8 @@ enum SysControlOpc: uint8_t {
   SYSCTL_OPC_GET_HOTEND_TYPE = 0x13,
   SYSCTL_OPC_GET_FILAMENT_STATE = 0x14,
   SYSCTL_OPC_GET_HOTEND_TEMP = 0x15,
+  SYSCTL_OPC_SET_TEMP_REPORT = 0x16,
+  SYSCTL_OPC_TEMP_REPORT = 0x17,   // sent to HMI only
 
   SYSCTL_OPC_MAX
 };
@@ -166,6 +168,7 @@ enum CameraOpc: uint8_t {
   CAMERA_OPC_SET_BT_NAME,
   CAMERA_OPC_READ_BT_NAME,
   CAMERA_OPC_READ_BT_MAC,
+  CAMERA_OPC_LASER_RASTER_DATA,
 
   CAMERA_OPC_MAX
 };
@@ -278,6 +281,8 @@ typedef struct {
   char buf[HMI_GCODE_PACK_SIZE];
 } HmiGcodeBufNode_t;
 
+extern RingBuffer<HmiGcodeBufNode_t> hmi_gcode_pack_buffer;
+
 typedef struct DispatcherParam* DispatcherParam_t;
 void event_handler_init();
 ErrCode DispatchEvent(DispatcherParam_t param);
@@ -287,6 +292,7 @@ void gocde_pack_start_line(uint32_t line);
 uint32_t gocde_pack_start_line();
 bool hmi_gcode_pack_mode();
 void check_and_request_gcode_again();
+void heat_wait_yield();
 extern bool Screen_send_ok[];
 
 extern UartHost hmi;
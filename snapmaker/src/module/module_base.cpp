@@ -22,6 +22,8 @@
 #include "can_host.h"
 
 #include "../service/upgrade.h"
+#include "../service/hotend_feedforward.h"
+#include "../service/mesh_slot.h"
 #include "../common/protocol_sstp.h"
 #include "../common/debug.h"
 #include "../hmi/event_handler.h"
@@ -334,6 +336,11 @@ extern uint32_t GRID_MAX_POINTS_Y;
 void ModuleBase::SetToolhead(ModuleToolHeadType toolhead) {
   bool need_saved = false;
 
+#if ENABLED(LEVELING_MESH_SLOTS)
+  // load the mesh probed with this toolhead, the one in use is kept in its slot
+  toolhead_ = toolhead;
+  need_saved = mesh_slot.Select(toolhead, mesh_slot.bed());
+#else
   // if plugged non-3DP toolhead, will reset leveling data
   if (toolhead != MODULE_TOOLHEAD_3DP && toolhead != MODULE_TOOLHEAD_DUALEXTRUDER) {
     for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
@@ -347,6 +354,7 @@ void ModuleBase::SetToolhead(ModuleToolHeadType toolhead) {
   }
 
   toolhead_ = toolhead;
+#endif
   set_min_planner_speed();
   if (need_saved)
     settings.save();
@@ -367,6 +375,10 @@ void ModuleBase::StaticProcess() {
   cnc.Process();
   cnc_200w.Process();
 
+#if ENABLED(HOTEND_FEEDFORWARD)
+  hotend_ff.Process();
+#endif
+
   if (++timer_in_static_process_ < 100) return;
   timer_in_static_process_ = 0;
 
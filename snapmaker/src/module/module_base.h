@@ -198,6 +198,8 @@ enum ModuleFunctionID {
   MODULE_FUNC_GET_IMPORTANT_INFO_1_FOR_DBG      ,  // 74
   MODULE_FUNC_GET_IMPORTANT_INFO_2_FOR_DBG      ,  // 75
   MODULE_FUNC_SET_STANDBY                       ,  // 76
+  MODULE_FUNC_SET_TEMP_REPORT_TIME              ,  // 77
+  MODULE_FUNC_SET_HEATER_FEEDFORWARD            ,  // 78
 
   MODULE_FUNC_MAX
 };
@@ -291,6 +293,8 @@ const uint8_t module_prio_table[][2] = {
   {/* MODULE_FUNC_GET_IMPORTANT_INFO_1_FOR_DBG */       MODULE_FUNC_PRIORITY_MEDIUM, 1},
   {/* MODULE_FUNC_GET_IMPORTANT_INFO_2_FOR_DBG */       MODULE_FUNC_PRIORITY_LOW, 0},
   {/* MODULE_FUNC_SET_STANDBY                       */  MODULE_FUNC_PRIORITY_MEDIUM, 1},
+  {/* MODULE_FUNC_SET_TEMP_REPORT_TIME              */  MODULE_FUNC_PRIORITY_LOW, 2},
+  {/* MODULE_FUNC_SET_HEATER_FEEDFORWARD            */  MODULE_FUNC_PRIORITY_MEDIUM, 2},
 };
 
 #define MODULE_EXT_CMD_INDEX_ID   (0)
@@ -21,6 +21,7 @@
 #include "toolhead_3dp.h"
 
 #include "../common/config.h"
+#include "../snapmaker.h"
 #include "common/debug.h"
 
 // marlin headers
@@ -47,6 +48,10 @@ static void CallbackAckProbeState(CanStdDataFrame_t &cmd) {
 static void CallbackAckNozzleTemp(CanStdDataFrame_t &cmd) {
   // temperature from module, was
   printer_single.SetTemp(cmd.data[0]<<8 | cmd.data[1], 0);
+#if ENABLED(EVENT_DRIVEN_HEAT_WAIT)
+  // wake up heating wait
+  xEventGroupSetBits(sm2_handle->event_group, EVENT_GROUP_TEMP_UPDATED);
+#endif
 }
 
 static void CallbackAckReportPidTemp(CanStdDataFrame_t &cmd) {
@@ -185,6 +190,15 @@ ErrCode ToolHead3DP::Init(MAC_t &mac, uint8_t mac_index) {
   SetToolhead(MODULE_TOOLHEAD_3DP);
   printer1 = this;
 
+#if ENABLED(VOLUMETRIC_FLOW_LIMIT)
+  planner.set_volumetric_extruder_limit(0, VOLUMETRIC_FLOW_DEFAULT);
+#endif
+
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+  if (SetTempReportInterval(HOTEND_TEMP_REPORT_INTERVAL) != E_SUCCESS)
+    LOG_I("\tmodule keeps its own temperature report rate\n");
+#endif
+
 out:
   return ret;
 }
@@ -325,13 +339,83 @@ void ToolHead3DP::SetTemp(int16_t temp, uint8_t extrude_index) {
   if (extrude_index >= 1)
     return;
 
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+  RecordTemp(temp, 0);
+#else
   cur_temp_[0] = temp;
+#endif
 
   if ((cur_temp_[0]/10) > thermalManager.temp_range[0].maxtemp) {
     systemservice.ThrowException(EHOST_HOTEND0, ETYPE_OVERRUN_MAXTEMP);
   }
 }
 
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+
+void ToolHead3DP::RecordTemp(int16_t temp, uint8_t extrude_index) {
+  if (extrude_index >= EXTRUDERS)
+    return;
+
+  uint32_t seq = temp_seq_[extrude_index];
+  TempSample_t &sample = temp_history_[extrude_index][seq % HOTEND_TEMP_HISTORY_SIZE];
+
+  sample.ms   = millis();
+  sample.temp = temp;
+  cur_temp_[extrude_index] = temp;
+
+  temp_seq_[extrude_index] = seq + 1;
+}
+
+
+uint8_t ToolHead3DP::GetTempHistory(TempSample_t *samples, uint8_t max, uint8_t extrude_index, uint32_t *newest) {
+  if (extrude_index >= EXTRUDERS)
+    return 0;
+
+  uint32_t seq = temp_seq_[extrude_index];
+  if (newest)
+    *newest = seq;
+
+  uint8_t count = (uint8_t)_MIN(seq, (uint32_t)_MIN(max, HOTEND_TEMP_HISTORY_SIZE));
+
+  for (uint8_t i = 0; i < count; i++)
+    samples[i] = temp_history_[extrude_index][(seq - 1 - i) % HOTEND_TEMP_HISTORY_SIZE];
+
+  // CAN task may have reused the oldest slots while we copied, drop them
+  uint32_t written = _MIN(temp_seq_[extrude_index] - seq, (uint32_t)HOTEND_TEMP_HISTORY_SIZE);
+  NOMORE(count, HOTEND_TEMP_HISTORY_SIZE - written);
+
+  return count;
+}
+
+
+millis_t ToolHead3DP::GetTempAge(uint8_t extrude_index) {
+  if (extrude_index >= EXTRUDERS)
+    return 0;
+
+  uint32_t seq = temp_seq_[extrude_index];
+  if (seq == 0)
+    return millis();
+
+  return millis() - temp_history_[extrude_index][(seq - 1) % HOTEND_TEMP_HISTORY_SIZE].ms;
+}
+
+
+ErrCode ToolHead3DP::SetTempReportInterval(uint16_t ms) {
+  CanStdFuncCmd_t cmd;
+  uint8_t buffer[2];
+
+  buffer[0]  = ms & 0xFF;
+  buffer[1]  = (ms>>8) & 0xFF;
+  cmd.id     = MODULE_FUNC_SET_TEMP_REPORT_TIME;
+  cmd.data   = buffer;
+  cmd.length = 2;
+
+  // E_PARAM if module didn't register this function
+  return canhost.SendStdCmd(cmd);
+}
+
+#endif // ENABLED(HOTEND_TEMP_TELEMETRY)
+
 void ToolHead3DP::NozzleFanCtrlCheck(void) {
   uint8_t nozzle_fan_index = 0XFF;
   uint8_t enable_fan = 0xFF;
@@ -61,6 +61,13 @@ typedef enum {
   DUAL_EXTRUDER_NOZZLE_FAN         = 2,
 }fan_e;
 
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+typedef struct {
+  millis_t ms;    // when it arrived
+  int16_t  temp;  // 0.1 degree
+} TempSample_t;
+#endif
+
 class ToolHead3DP: public ModuleBase {
   public:
     ToolHead3DP(ModuleDeviceID id): ModuleBase(id) {
@@ -151,6 +158,20 @@ class ToolHead3DP: public ModuleBase {
       return cur_temp_[extrude_index];
     }
 
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+    // called in CAN callback for every temperature reported by module
+    void RecordTemp(int16_t temp, uint8_t extrude_index=0);
+    // copy up to max samples, newest first, return the count
+    // newest gets temp_seq() as it was when samples[0] was the latest
+    uint8_t GetTempHistory(TempSample_t *samples, uint8_t max, uint8_t extrude_index=0, uint32_t *newest=NULL);
+    // number of samples received since power on, to find new ones
+    uint32_t temp_seq(uint8_t extrude_index=0) { return temp_seq_[extrude_index]; }
+    // ms since last sample, from the timestamp instead of the value
+    millis_t GetTempAge(uint8_t extrude_index=0);
+    // ask module to report temperature every ms, fails if module doesn't support it
+    ErrCode SetTempReportInterval(uint16_t ms);
+#endif
+
     void UpdateEAxisStepsPerUnit(ModuleToolHeadType type);
 
     virtual void UpdateHotendMaxTemp(int16_t temp, uint8_t e = 0);
@@ -158,6 +179,11 @@ class ToolHead3DP: public ModuleBase {
     // for dualextruder
     virtual ErrCode ToolChange(uint8_t new_extruder, bool use_compensation = true) { return E_SUCCESS; }
     virtual void SelectProbeSensor(probe_sensor_t sensor) { return; }
+#if ENABLED(DUAL_PROBE_CAPTURE)
+    virtual void ArmProbeCapture(probe_sensor_t sensor) { return; }
+    virtual void DisarmProbeCapture() { return; }
+    virtual float probe_capture() { return NAN; }
+#endif
     virtual void SetZCompensation(float comp, uint32_t e = 0) { return; }
     void GetZCompensation(float &left_z_compensation, float &right_z_compensation) { return; }
     virtual void GetDualExtruderZCompensation(float &left_z_compensation, float &right_z_compensation) { return; }
@@ -192,6 +218,12 @@ class ToolHead3DP: public ModuleBase {
     float pid_[3];
     uint16_t timer_in_process_;
 
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+    TempSample_t temp_history_[EXTRUDERS][HOTEND_TEMP_HISTORY_SIZE];
+    // written after the sample by CAN task, so readers can detect overwriting
+    volatile uint32_t temp_seq_[EXTRUDERS] = { 0 };
+#endif
+
   private:
     uint8_t mac_index_;
 };
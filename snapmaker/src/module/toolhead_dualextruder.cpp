@@ -21,7 +21,11 @@
 
 #include "toolhead_dualextruder.h"
 #include "../common/config.h"
+#include "../snapmaker.h"
 #include "common/debug.h"
+#include "../service/bed_level.h"
+#include "../service/nozzle_profile.h"
+#include "../service/idle_nozzle_preheat.h"
 
 // marlin headers
 #include "src/core/macros.h"
@@ -56,6 +60,10 @@ static void CallbackAckNozzleTemp(CanStdDataFrame_t &cmd) {
     return;
 
   printer_dualextruder.ReportTemperature(cmd.data);
+#if ENABLED(EVENT_DRIVEN_HEAT_WAIT)
+  // wake up heating wait
+  xEventGroupSetBits(sm2_handle->event_group, EVENT_GROUP_TEMP_UPDATED);
+#endif
 }
 
 static void CallbackAckReportPidTemp(CanStdDataFrame_t &cmd) {
@@ -204,6 +212,18 @@ ErrCode ToolHeadDualExtruder::Init(MAC_t &mac, uint8_t mac_index) {
   ModuleCtrlHotendOffsetSync();
   ModuleCtrlRightExtruderPosSync();
 
+#if ENABLED(VOLUMETRIC_FLOW_LIMIT)
+  // until the nozzle types are reported
+  for (uint8_t e = 0; e < EXTRUDERS; e++)
+    if (hotend_type_[e] == INVALID_HOTEND_TYPE)
+      planner.set_volumetric_extruder_limit(e, VOLUMETRIC_FLOW_DEFAULT);
+#endif
+
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+  if (SetTempReportInterval(HOTEND_TEMP_REPORT_INTERVAL) != E_SUCCESS)
+    LOG_I("\tmodule keeps its own temperature report rate\n");
+#endif
+
   CheckLevelingData();
 
   LOG_I("dualextruder ready!\n");
@@ -241,6 +261,18 @@ void ToolHeadDualExtruder::GetHWVersion() {
 }
 
 void ToolHeadDualExtruder::ReportProbeState(uint8_t state[]) {
+#if ENABLED(DUAL_PROBE_CAPTURE)
+  // module reports as soon as a sensor changes, so Z at this moment is where it triggered
+  if (capture_sensor_ < PROBE_SENSOR_LEFT_CONDUCTIVE) {
+    const bool was = TEST(probe_state_, capture_sensor_) != Z_MIN_PROBE_ENDSTOP_INVERTING;
+    const bool now = (bool)state[capture_sensor_] != Z_MIN_PROBE_ENDSTOP_INVERTING;
+    if (now && !was) {
+      capture_z_ = planner.get_axis_position_mm(Z_AXIS);
+      capture_count_++;
+    }
+  }
+#endif
+
   if (state[0]) {
     probe_state_ |= 0x01;
   } else {
@@ -264,11 +296,19 @@ void ToolHeadDualExtruder::ReportProbeState(uint8_t state[]) {
 #define ERR_OVERTEMP_BIT_MASK         (0)
 #define ERR_INVALID_NOZZLE_BIT_MASK   (1)
 void ToolHeadDualExtruder::ReportTemperature(uint8_t *data) {
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+  RecordTemp(data[0] << 8 | data[1], 0);
+#else
   cur_temp_[0] = data[0] << 8 | data[1];
+#endif
   if (data[2] & (1<<ERR_OVERTEMP_BIT_MASK)) {
     systemservice.ThrowException(EHOST_HOTEND0, ETYPE_OVERRUN_MAXTEMP);
   }
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+  RecordTemp(data[4] << 8 | data[5], 1);
+#else
   cur_temp_[1] = data[4] << 8 | data[5];
+#endif
   if (data[6] & (1<<ERR_OVERTEMP_BIT_MASK)) {
     systemservice.ThrowException(EHOST_HOTEND1, ETYPE_OVERRUN_MAXTEMP);
   }
@@ -327,6 +367,16 @@ void ToolHeadDualExtruder::ReportHotendType(uint8_t *data) {
         hotend_type_[i] = hotend_info[HOTEND_INFO_MAX].model;
         hotend_diameter_[i] = hotend_info[HOTEND_INFO_MAX].diameter;
       }
+
+      #if ENABLED(VOLUMETRIC_FLOW_LIMIT)
+        const float max_flow = data[i] < HOTEND_INFO_MAX ? hotend_info[data[i]].max_flow : 0;
+        planner.set_volumetric_extruder_limit(i, max_flow > 0 ? max_flow : VOLUMETRIC_FLOW_DEFAULT);
+      #endif
+
+      #if ENABLED(NOZZLE_MOTION_PROFILE)
+        // applied later in Marlin task
+        nozzle_profile.Detected(i, data[i]);
+      #endif
     }
   }
 
@@ -792,6 +842,17 @@ void ToolHeadDualExtruder::SelectProbeSensor(probe_sensor_t sensor) {
   active_probe_sensor_ = sensor;
 }
 
+#if ENABLED(DUAL_PROBE_CAPTURE)
+void ToolHeadDualExtruder::ArmProbeCapture(probe_sensor_t sensor) {
+  if (sensor >= PROBE_SENSOR_LEFT_CONDUCTIVE) {
+    return;
+  }
+
+  capture_count_ = 0;
+  capture_sensor_ = sensor;
+}
+#endif
+
 void ToolHeadDualExtruder::SetZCompensation(float comp, uint32_t e) {
   z_compensation_[e] = comp;
   ModuleCtrlSaveZCompensation(comp, e);
@@ -808,18 +869,15 @@ void ToolHeadDualExtruder::GetDualExtruderZCompensation(float &left_z_compensati
 
 
 ErrCode ToolHeadDualExtruder::ToolChange(uint8_t new_extruder, bool use_compensation/* = true */) {
-  volatile int32_t xdiff_scaled, ydiff_scaled, zdiff_scaled;
-  volatile float xdiff, ydiff, zdiff;
-  volatile float hotend_offset_tmp[XYZ][HOTENDS] {0};
-  volatile float z_raise = 0;
+  int32_t xdiff_scaled, ydiff_scaled, zdiff_scaled;
+  float xdiff, ydiff, zdiff;
+  float hotend_offset_tmp[XYZ][HOTENDS] {0};
+  float z_raise = 0;
 
   float pre_position[X_TO_E];
 
-  volatile uint32_t old_extruder;
-
-  planner.synchronize();
-
-  const bool leveling_was_active = planner.leveling_active;
+  uint8_t old_extruder;
+  ErrCode ret = E_SUCCESS;
 
   if (new_extruder >= EXTRUDERS) {
     return E_PARAM;
@@ -830,111 +888,155 @@ ErrCode ToolHeadDualExtruder::ToolChange(uint8_t new_extruder, bool use_compensa
     return E_FAILURE;
   }
 
-  if (new_extruder != active_extruder) {
-    LOOP_XYZ(i) {
-      HOTEND_LOOP() {
-        hotend_offset_tmp[i][e] = hotend_offset[i][e];
-      }
-    }
+  if (new_extruder == active_extruder)
+    return E_SUCCESS;
 
-    if (!use_compensation) {
-      hotend_offset_tmp[Z_AXIS][1] = 0;
+  LOOP_XYZ(i) {
+    HOTEND_LOOP() {
+      hotend_offset_tmp[i][e] = hotend_offset[i][e];
     }
+  }
+
+  if (!use_compensation) {
+    hotend_offset_tmp[Z_AXIS][1] = 0;
+  }
+
+  planner.synchronize();
+  taskENTER_CRITICAL();
+  LOOP_X_TO_EN(i) backup_current_position[i] = current_position[i];
+  backup_position_valid = true;
+  taskEXIT_CRITICAL();
 
-    planner.synchronize();
-    taskENTER_CRITICAL();
-    LOOP_X_TO_EN(i) backup_current_position[i] = current_position[i];
-    backup_position_valid = true;
-    taskEXIT_CRITICAL();
+  const bool leveling_was_active = planner.leveling_active;
+  set_bed_leveling_enabled(false);
 
-    set_bed_leveling_enabled(false);
+  LOG_I("\norigin pos: %.3f, %.3f, %.3f\n", current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS]);
 
-    LOG_I("\norigin pos: %.3f, %.3f, %.3f\n", current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS]);
+  z_raise = current_position[Z_AXIS] + toolchange_settings.z_raise;
 
-    z_raise = current_position[Z_AXIS] + toolchange_settings.z_raise;
+  NOMORE(z_raise, soft_endstop[Z_AXIS].max);
 
-    NOMORE(z_raise, soft_endstop[Z_AXIS].max);
+  z_raise = z_raise - current_position[Z_AXIS];
 
-    z_raise = z_raise - current_position[Z_AXIS];
+  LOG_I("raise: %.3f, endstop max: %.3f, z offset: %.3f\n", z_raise, soft_endstop[Z_AXIS].max, hotend_offset_tmp[Z_AXIS][1]);
 
-    LOG_I("raise: %.3f, endstop max: %.3f, z offset: %.3f\n", z_raise, soft_endstop[Z_AXIS].max, hotend_offset_tmp[Z_AXIS][1]);
+  do_blocking_move_to_z(current_position[Z_AXIS] + z_raise, 30);
 
-    do_blocking_move_to_z(current_position[Z_AXIS] + z_raise, 30);
+  LOG_I("raised pos: %.3f, %.3f, %.3f\n", current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS]);
 
-    LOG_I("raised pos: %.3f, %.3f, %.3f\n", current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS]);
+#if ENABLED(IDLE_NOZZLE_PREHEAT)
+  // new nozzle may still be at standby, heat it while head is clear of the print
+  nozzle_preheat.PrepareSwap(new_extruder);
+#endif
 
-    // remove live z offset of old extruder after raise Z, cause Z will fall in unapplying live offset
-    levelservice.UnapplyLiveZOffset(active_extruder);
-    // to avoid power-loss, we record the new extruder  after unapply z offset!
-    old_extruder = active_extruder;
-    active_extruder = new_extruder;
-    actual_extruder = new_extruder;
+  // left nozzle drops here, when head is stopped and fully raised above the print
+  if (new_extruder == 0) {
+    ret = ModuleCtrlToolChange(new_extruder);
+    if (ret != E_SUCCESS)
+      goto lower;
+  }
 
-    //set_destination_from_current();
-    COPY(pre_position, current_position);
+  // remove live z offset of old extruder after raise Z, cause Z will fall in unapplying live offset
+  levelservice.UnapplyLiveZOffset(active_extruder);
+  // to avoid power-loss, we record the new extruder  after unapply z offset!
+  old_extruder = active_extruder;
+  active_extruder = new_extruder;
+  actual_extruder = new_extruder;
 
-    if (new_extruder > old_extruder) {
-      // left -> right, toolhead will move to left, make sure there is enough space in left for the moving
-      if (current_position[X_AXIS] < X_MIN_POS + hotend_offset_tmp[X_AXIS][1]) {
-        do_blocking_move_to_xy(X_MIN_POS + hotend_offset_tmp[X_AXIS][1], current_position[Y_AXIS], 50);
-      }
+  COPY(pre_position, current_position);
+
+  if (new_extruder > old_extruder) {
+    // left -> right, toolhead will move to left, make sure there is enough space in left for the moving
+    if (current_position[X_AXIS] < X_MIN_POS + hotend_offset_tmp[X_AXIS][1]) {
+      do_blocking_move_to_xy(X_MIN_POS + hotend_offset_tmp[X_AXIS][1], current_position[Y_AXIS], 50);
     }
-    else {
-      // right -> left, toolhead will move to right, make sure there is enough space in right for the moving
-      if (current_position[X_AXIS] > X_MAX_POS - hotend_offset_tmp[X_AXIS][1]) {
-        do_blocking_move_to_xy(X_MAX_POS - hotend_offset_tmp[X_AXIS][1], current_position[Y_AXIS], 50);
-      }
+  }
+  else {
+    // right -> left, toolhead will move to right, make sure there is enough space in right for the moving
+    if (current_position[X_AXIS] > X_MAX_POS - hotend_offset_tmp[X_AXIS][1]) {
+      do_blocking_move_to_xy(X_MAX_POS - hotend_offset_tmp[X_AXIS][1], current_position[Y_AXIS], 50);
     }
+  }
 
-    update_software_endstops(X_AXIS, old_extruder, new_extruder);
-    update_software_endstops(Y_AXIS, old_extruder, new_extruder);
-    update_software_endstops(Z_AXIS, old_extruder, new_extruder);
+  update_software_endstops(X_AXIS, old_extruder, new_extruder);
+  update_software_endstops(Y_AXIS, old_extruder, new_extruder);
+  update_software_endstops(Z_AXIS, old_extruder, new_extruder);
+
+  xdiff = hotend_offset_tmp[X_AXIS][new_extruder] - hotend_offset_tmp[X_AXIS][old_extruder];
+  ydiff = hotend_offset_tmp[Y_AXIS][new_extruder] - hotend_offset_tmp[Y_AXIS][old_extruder];
+  zdiff = hotend_offset_tmp[Z_AXIS][new_extruder] - hotend_offset_tmp[Z_AXIS][old_extruder];
+  xdiff_scaled = xdiff * planner.settings.axis_steps_per_mm[X_AXIS];
+  ydiff_scaled = ydiff * planner.settings.axis_steps_per_mm[Y_AXIS];
+  zdiff_scaled = zdiff * planner.settings.axis_steps_per_mm[Z_AXIS];
+  xdiff = (float)xdiff_scaled / planner.settings.axis_steps_per_mm[X_AXIS];
+  ydiff = (float)ydiff_scaled / planner.settings.axis_steps_per_mm[Y_AXIS];
+  zdiff = (float)zdiff_scaled / planner.settings.axis_steps_per_mm[Z_AXIS];
+  current_position[X_AXIS] += xdiff;
+  current_position[Y_AXIS] += ydiff;
+  current_position[Z_AXIS] += zdiff;
+  LOG_I("offset pos: %.3f, %.3f, %.3f\n", current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS]);
+  sync_plan_position();
+
+  apply_motion_limits(pre_position);
+  do_blocking_move_to(pre_position);
+
+  // right nozzle drops after the travel, when head is stopped above the print
+  if (new_extruder == 1) {
+    ret = ModuleCtrlToolChange(new_extruder);
+    if (ret != E_SUCCESS)
+      goto rollback;
+  }
 
-    if (new_extruder == 0) {
-      ModuleCtrlToolChange(new_extruder);
-    }
+#if ENABLED(NOZZLE_MOTION_PROFILE)
+  // descent and what follows run with the profile of new nozzle
+  nozzle_profile.Apply();
+#endif
 
-    xdiff = hotend_offset_tmp[X_AXIS][new_extruder] - hotend_offset_tmp[X_AXIS][old_extruder];
-    ydiff = hotend_offset_tmp[Y_AXIS][new_extruder] - hotend_offset_tmp[Y_AXIS][old_extruder];
-    zdiff = hotend_offset_tmp[Z_AXIS][new_extruder] - hotend_offset_tmp[Z_AXIS][old_extruder];
-    xdiff_scaled = xdiff * planner.settings.axis_steps_per_mm[X_AXIS];
-    ydiff_scaled = ydiff * planner.settings.axis_steps_per_mm[Y_AXIS];
-    zdiff_scaled = zdiff * planner.settings.axis_steps_per_mm[Z_AXIS];
-    // Ensure that the divisor is not zero
-    // todo
-    xdiff = (float)xdiff_scaled / planner.settings.axis_steps_per_mm[X_AXIS];
-    ydiff = (float)ydiff_scaled / planner.settings.axis_steps_per_mm[Y_AXIS];
-    zdiff = (float)zdiff_scaled / planner.settings.axis_steps_per_mm[Z_AXIS];
-    current_position[X_AXIS] += xdiff;
-    current_position[Y_AXIS] += ydiff;
-    current_position[Z_AXIS] += zdiff;
-    LOG_I("offset pos: %.3f, %.3f, %.3f\n", current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS]);
-    sync_plan_position();
-
-    apply_motion_limits(pre_position);
-    do_blocking_move_to(pre_position);
-
-    if (new_extruder == 1) {
-      ModuleCtrlToolChange(new_extruder);
-    }
+  // here we should apply live z offset of new extruder!
+  levelservice.ApplyLiveZOffset(active_extruder);
 
-    // here we should apply live z offset of new extruder!
-    levelservice.ApplyLiveZOffset(active_extruder);
+  do_blocking_move_to_z(current_position[Z_AXIS] - z_raise, 30);
 
-    do_blocking_move_to_z(current_position[Z_AXIS] - z_raise, 30);
+  LOG_I("descent pos: %.3f, %.3f, %.3f\n\n", current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS]);
 
-    LOG_I("descent pos: %.3f, %.3f, %.3f\n\n", current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS]);
+  // after swtich extruder, just select relative OPTOCOUPLER
+  SelectProbeSensor((probe_sensor_t)(PROBE_SENSOR_LEFT_OPTOCOUPLER + new_extruder));
+  goto out;
 
-    // after swtich extruder, just select relative OPTOCOUPLER
-    SelectProbeSensor((probe_sensor_t)(PROBE_SENSOR_LEFT_OPTOCOUPLER + new_extruder));
-  }
+rollback:
+  // right nozzle didn't drop, left one is still working: switch back to it
+  active_extruder = old_extruder;
+  actual_extruder = old_extruder;
+
+  update_software_endstops(X_AXIS, new_extruder, old_extruder);
+  update_software_endstops(Y_AXIS, new_extruder, old_extruder);
+  update_software_endstops(Z_AXIS, new_extruder, old_extruder);
+
+  current_position[X_AXIS] -= xdiff;
+  current_position[Y_AXIS] -= ydiff;
+  current_position[Z_AXIS] -= zdiff;
+  sync_plan_position();
+
+  do_blocking_move_to_xy(backup_current_position[X_AXIS], backup_current_position[Y_AXIS], 50);
+
+  levelservice.ApplyLiveZOffset(active_extruder);
 
+lower:
+  // nozzle didn't switch, put head back to where it was, so the pause which
+  // caller triggers saves and resumes from the position of old extruder
+  do_blocking_move_to_z(current_position[Z_AXIS] - z_raise, 30);
+
+  LOG_E("failed to switch to extruder %u, stay on %u\n", new_extruder, active_extruder);
+  LOG_I("rollback pos: %.3f, %.3f, %.3f\n\n", current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS]);
+
+out:
   set_bed_leveling_enabled(leveling_was_active);
+
   taskENTER_CRITICAL();
   backup_position_valid = false;
   taskEXIT_CRITICAL();
 
-  return E_SUCCESS;
+  return ret;
 }
 
 // hmi interface
@@ -35,6 +35,7 @@
 typedef struct {
   uint8_t model;
   float diameter;
+  float max_flow;   // (mm³/s) what the nozzle can melt, 0 for unknown
 }hotend_type_info_t;
 
 typedef struct {
@@ -44,17 +45,17 @@ typedef struct {
 
 #define INVALID_HOTEND_TYPE (0xff)
 #define HOTEND_INFO_MAX 10
-const hotend_type_info_t hotend_info[HOTEND_INFO_MAX + 1] = {{.model = 2, .diameter = 0.4}, \
-                                                         {.model = 1, .diameter = 0.6}, \
-                                                         {.model = 1, .diameter = 0.8}, \
-                                                         {.model = 1, .diameter = 0.4},\
-                                                         {.model = 1, .diameter = 0.2},\
-                                                         {.model = INVALID_HOTEND_TYPE, .diameter = 0},\
-                                                         {.model = INVALID_HOTEND_TYPE, .diameter = 0},\
-                                                         {.model = INVALID_HOTEND_TYPE, .diameter = 0},\
-                                                         {.model = INVALID_HOTEND_TYPE, .diameter = 0},\
-                                                         {.model = INVALID_HOTEND_TYPE, .diameter = 0},\
-                                                         {.model = INVALID_HOTEND_TYPE, .diameter = 0}\
+const hotend_type_info_t hotend_info[HOTEND_INFO_MAX + 1] = {{.model = 2, .diameter = 0.4, .max_flow = 12}, \
+                                                         {.model = 1, .diameter = 0.6, .max_flow = 18}, \
+                                                         {.model = 1, .diameter = 0.8, .max_flow = 22}, \
+                                                         {.model = 1, .diameter = 0.4, .max_flow = 12},\
+                                                         {.model = 1, .diameter = 0.2, .max_flow = 3},\
+                                                         {.model = INVALID_HOTEND_TYPE, .diameter = 0, .max_flow = 0},\
+                                                         {.model = INVALID_HOTEND_TYPE, .diameter = 0, .max_flow = 0},\
+                                                         {.model = INVALID_HOTEND_TYPE, .diameter = 0, .max_flow = 0},\
+                                                         {.model = INVALID_HOTEND_TYPE, .diameter = 0, .max_flow = 0},\
+                                                         {.model = INVALID_HOTEND_TYPE, .diameter = 0, .max_flow = 0},\
+                                                         {.model = INVALID_HOTEND_TYPE, .diameter = 0, .max_flow = 0}\
                                                         };
 
 class ToolHeadDualExtruder: public ToolHead3DP {
@@ -76,6 +77,13 @@ class ToolHeadDualExtruder: public ToolHead3DP {
     bool filament_state();
     bool filament_state(uint8_t e);
     void SelectProbeSensor(probe_sensor_t sensor);
+#if ENABLED(DUAL_PROBE_CAPTURE)
+    // latch Z where the sensor triggers, while the active sensor stops the move
+    void ArmProbeCapture(probe_sensor_t sensor);
+    void DisarmProbeCapture() { capture_sensor_ = PROBE_SENSOR_INVALID; }
+    // Z of the last trigger since armed, NAN if it didn't trigger
+    float probe_capture() { return capture_count_ ? capture_z_ : NAN; }
+#endif
     void SetZCompensation(float comp, uint32_t e = 0);
     void GetZCompensation(float &left_z_compensation, float &right_z_compensation);
     void GetDualExtruderZCompensation(float &left_z_compensation, float &right_z_compensation);
@@ -143,6 +151,11 @@ class ToolHeadDualExtruder: public ToolHead3DP {
     bool backup_position_valid;
     float backup_current_position[X_TO_E];
     bool has_sync;
+#if ENABLED(DUAL_PROBE_CAPTURE)
+    volatile probe_sensor_t capture_sensor_ = PROBE_SENSOR_INVALID;
+    volatile uint8_t capture_count_ = 0;
+    volatile float capture_z_;
+#endif
 };
 
 extern ToolHeadDualExtruder printer_dualextruder;
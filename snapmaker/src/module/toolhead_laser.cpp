@@ -35,7 +35,9 @@
 #include "src/module/planner.h"
 #include "rotary_module.h"
 #include "src/module/stepper.h"
+#include "src/module/ft_motion.h"
 #include "../service/system.h"
+#include "../service/job_align.h"
 #include "toolhead_3dp.h"
 
 
@@ -737,7 +739,12 @@ ErrCode ToolHeadLaser::SetCrossLightOffsetCAN(float x, float y) {
   cmd.data      = buffer;
   cmd.length    = 8;
 
-  return canhost.SendStdCmd(cmd);
+  ErrCode ret = canhost.SendStdCmd(cmd);
+#if ENABLED(JOB_ALIGNMENT)
+  if (E_SUCCESS == ret && !CheckCrossLightOffset(x, y))
+    job_align.CacheCrossLight(mac(), x, y);
+#endif
+  return ret;
 }
 
 
@@ -750,7 +757,7 @@ ErrCode ToolHeadLaser::GetCrossLightOffsetCAN(float &x, float &y) {
   ErrCode ret = canhost.SendStdCmd(cmd);
   if (E_SUCCESS != ret) {
     LOG_E("Get CrossLightOffset send msg failed\n");
-    return ret;
+    return CachedCrossLightOffset(x, y, ret);
   }
 
   int32_t max_try = 500;
@@ -762,13 +769,25 @@ ErrCode ToolHeadLaser::GetCrossLightOffsetCAN(float &x, float &y) {
   }
   else {
     LOG_E("Get CrossLightOffset time out\n");
-    return E_TIMEOUT;
+    return CachedCrossLightOffset(x, y, E_TIMEOUT);
   }
 
   if (CheckCrossLightOffset(crosslight_offset_x, crosslight_offset_y))
     return E_FAILURE;
-  else
+
+  TERN_(JOB_ALIGNMENT, job_align.CacheCrossLight(mac(), x, y));
+  return E_SUCCESS;
+}
+
+// module didn't answer, take what it said last time
+ErrCode ToolHeadLaser::CachedCrossLightOffset(float &x, float &y, ErrCode err) {
+#if ENABLED(JOB_ALIGNMENT)
+  if (job_align.CachedCrossLight(mac(), x, y)) {
+    LOG_W("Use cached CrossLightOffset X: %f, Y: %f\n", x, y);
     return E_SUCCESS;
+  }
+#endif
+  return err;
 }
 
 ErrCode ToolHeadLaser::CheckCrossLightOffset(float x_offset, float y_offset) {
@@ -978,6 +997,49 @@ ErrCode ToolHeadLaser::DoAutoFocusing(SSTP_Event_t &event) {
   // Move to next Z
   move_to_limited_z(next_z, 20.0f);
 
+#if ENABLED(LASER_FOCUS_SWEEP)
+  {
+    const laser_state_t saved_laser = planner.laser_inline;
+    const ftMotionMode_t ft_mode = ftMotion.disable();  // FT motion doesn't carry inline power
+    // no output while security is triggered, as SetOutput() does
+    const uint16_t draw_pwm = security_status_ ? 0 : PowerConversionPwm(laser_pwr_in_cali);
+    float dest[XYZ];
+
+    // enables the module and its fan once, moves only switch the power afterwards
+    SetOutputInline(laser_pwr_in_cali);
+    planner.laser_inline.status.isEnabled = true;
+    planner.laser_inline.status.trapezoid_power = false;
+    planner.laser_inline.status.is_sync_power = true;
+    planner.laser_inline.status.power_is_map = true;
+
+    for (i = 0; i < Count; i++) {
+      // to the start of the line and its Z in one move, laser off
+      dest[X_AXIS] = next_x;
+      dest[Y_AXIS] = next_y;
+      dest[Z_AXIS] = next_z + i * z_interval;
+      apply_motion_limits(dest);
+      UpdateInlinePower(0, 0);
+      COPY(current_position, dest);
+      line_to_current_position(speed_in_calibration[X_AXIS]);
+
+      // draw the line
+      dest[Y_AXIS] = next_y + (((i % 5) == 0) ? line_len_long : line_len_short);
+      apply_motion_limits(dest);
+      UpdateInlinePower(draw_pwm, laser_pwr_in_cali);
+      COPY(current_position, dest);
+      line_to_current_position(speed_in_draw_ruler);
+
+      next_x = next_x + line_space;
+    }
+
+    UpdateInlinePower(0, 0);
+    planner.synchronize();
+
+    planner.laser_inline = saved_laser;
+    ftMotion.setMode(ft_mode);
+    SetOutput(0);
+  }
+#else
   // Draw 10 Line
   do {
     // Move to the start point
@@ -1005,6 +1067,7 @@ ErrCode ToolHeadLaser::DoAutoFocusing(SSTP_Event_t &event) {
     next_x = next_x + line_space;
     i++;
   } while(i < Count);
+#endif // LASER_FOCUS_SWEEP
 
   planner.synchronize();
 
@@ -1748,11 +1811,16 @@ void ToolHeadLaser::SetOutputInline(float power) {
 }
 
 void ToolHeadLaser::SetOutputInline(uint16_t power_pwm, bool is_sync_power) {
-  CheckFan(power_pwm);
   planner.laser_inline.power = power_pwm;
   if (is_sync_power)
     planner.laser_inline.sync_power = power_pwm * 100.0 / 255.0;
 
+  PrepareInline(power_pwm);
+}
+
+void ToolHeadLaser::PrepareInline(uint16_t power_pwm) {
+  CheckFan(power_pwm);
+
   if ((laser->device_id_ == MODULE_DEVICE_ID_10W_LASER || laser->device_id_ == MODULE_DEVICE_ID_20W_LASER ||
       laser->device_id_ == MODULE_DEVICE_ID_40W_LASER || laser->device_id_ == MODULE_DEVICE_ID_LASER_RED_2W_2023)) {
     if (power_pwm > 0) {
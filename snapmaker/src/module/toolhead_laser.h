@@ -251,6 +251,7 @@ class ToolHeadLaser: public ModuleBase {
     ErrCode LoadFocus();
     ErrCode ReadBluetoothInfo(LaserCameraCommand cmd, uint8_t *out, uint16_t &length);
     ErrCode SetBluetoothInfo(LaserCameraCommand cmd, uint8_t *info, uint16_t length);
+    ErrCode CachedCrossLightOffset(float &x, float &y, ErrCode err);
 
   private:
     uint8_t *power_table_;
@@ -315,6 +316,9 @@ class ToolHeadLaser: public ModuleBase {
     void SetOutputInline(uint16_t power_pwm, bool is_sync_power=true);
     void UpdateInlinePower(uint16_t power_pwm, float sync_power);
 
+    // Turn on fan and module enable for blocks whose power is set by the stepper ISR
+    void PrepareInline(uint16_t power_pwm);
+
     // Optimized TurnOn function for use from the Stepper ISR
     void TurnOn_ISR(uint16_t power_pwm, bool is_sync_power, float power);
 };
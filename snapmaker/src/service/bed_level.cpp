@@ -141,7 +141,7 @@ ErrCode BedLevelService::DoAutoLeveling(SSTP_Event_t &event) {
     if (event.op_code == SETTINGS_OPC_DO_AUTO_LEVELING)
       err = auto_probing(true, false);
     else
-      err = auto_probing(true, true);
+      err = auto_probing(true, true, ENABLED(QUICK_AUTO_PROBING));
 
     endstops.enable_z_probe(false);
 
@@ -689,6 +689,34 @@ ErrCode BedLevelService::ProbeSensorCalibraitonAbort() {
   return E_SUCCESS;
 }
 
+// center point, or the left-front one of the center for even grid
+static uint8_t CenterIndex(uint32_t points) {
+  uint8_t index = (uint8_t)(points / 2);
+  if (!(points % 2) && (index > 0))
+    index--;
+  return index;
+}
+
+#if ENABLED(DUAL_PROBE_CAPTURE)
+// bilinear height of the probed grid at XY, NAN if XY is out of the grid
+float BedLevelService::ProbedHeight(float x, float y) {
+  const float rx = (x - bilinear_start[X_AXIS]) / bilinear_grid_spacing[X_AXIS],
+              ry = (y - bilinear_start[Y_AXIS]) / bilinear_grid_spacing[Y_AXIS];
+
+  if (!WITHIN(rx, 0, GRID_MAX_POINTS_X - 1) || !WITHIN(ry, 0, GRID_MAX_POINTS_Y - 1))
+    return NAN;
+
+  const uint8_t gx = MIN((uint8_t)rx, (uint8_t)(GRID_MAX_POINTS_X - 2)),
+                gy = MIN((uint8_t)ry, (uint8_t)(GRID_MAX_POINTS_Y - 2));
+  const float fx = rx - gx, fy = ry - gy;
+
+  const float z1 = z_values_tmp[gx][gy]     + (z_values_tmp[gx + 1][gy]     - z_values_tmp[gx][gy])     * fx,
+              z2 = z_values_tmp[gx][gy + 1] + (z_values_tmp[gx + 1][gy + 1] - z_values_tmp[gx][gy + 1]) * fx;
+
+  return z1 + (z2 - z1) * fy;
+}
+#endif
+
 ErrCode BedLevelService::DoDualExtruderAutoLeveling(SSTP_Event_t &event) {
   ErrCode err = E_SUCCESS;
   uint8_t grid = 3;
@@ -723,6 +751,10 @@ ErrCode BedLevelService::DoDualExtruderAutoLeveling(SSTP_Event_t &event) {
   live_z_offset_[0] = 0;
   live_z_offset_[1] = 0;
 
+#if ENABLED(DUAL_PROBE_CAPTURE)
+  touch_captured_ = false;
+#endif
+
   // clear temporary buffer
   for (int x = 0; x < GRID_MAX_NUM; x++) {
     for (int y = 0; y < GRID_MAX_NUM; y++) {
@@ -793,6 +825,27 @@ ErrCode BedLevelService::DualExtruderAutoLevelingProbePoint(SSTP_Event_t &event)
   printer1->ModuleCtrlProximitySwitchPower(1);
 
   printer1->ModuleCtrlSetExtruderChecking(false);
+#if ENABLED(DUAL_PROBE_CAPTURE)
+  if (probe_point_ > 0) {
+    // the point Finish will touch with left nozzle, take the touch in the same descent
+    if (x_index == CenterIndex(GRID_MAX_POINTS_X) && y_index == CenterIndex(GRID_MAX_POINTS_Y)) {
+      z_values_tmp[x_index][y_index] = probe_pt_capture(probe_x, probe_y, current_position[Z_AXIS], captured_touch_z_);
+      captured_touch_x_ = probe_x;
+      captured_touch_y_ = probe_y;
+      touch_captured_ = !isnan(captured_touch_z_);
+    }
+    else {
+      z_values_tmp[x_index][y_index] = probe_pt_quick(probe_x, probe_y, current_position[Z_AXIS], false);
+    }
+
+    // next point starts a little above this one, as G1029 Q1 does
+    if (!isnan(z_values_tmp[x_index][y_index])) {
+      current_position[Z_AXIS] = z_values_tmp[x_index][y_index] - zprobe_zoffset + QUICK_PROBING_CLEARANCE;
+      line_to_current_position(MMM_TO_MMS(Z_PROBE_SPEED_FAST));
+    }
+  }
+  else
+#endif
   z_values_tmp[x_index][y_index]  = probe_pt(probe_x, probe_y, PROBE_PT_RAISE, 0, false);
   printer1->ModuleCtrlSetExtruderChecking(true);
 
@@ -827,17 +880,22 @@ ErrCode BedLevelService::FinishDualExtruderAutoLeveling(SSTP_Event_t &event) {
   }
 
   // move to center or left-front of Bed
-  x_index     = (uint8_t)(GRID_MAX_POINTS_X / 2);
-  if (!(GRID_MAX_POINTS_X % 2) && (x_index > 0))
-    x_index--;
-
-  y_index     = (uint8_t)(GRID_MAX_POINTS_Y / 2);
-  if (!(GRID_MAX_POINTS_Y % 2) && (y_index > 0))
-    y_index--;
+  x_index     = CenterIndex(GRID_MAX_POINTS_X);
+  y_index     = CenterIndex(GRID_MAX_POINTS_Y);
 
   probe_x     = _GET_MESH_X(x_index);
   probe_y     = _GET_MESH_Y(y_index);
 
+#if ENABLED(DUAL_PROBE_CAPTURE)
+  left_extruder_auto_probe_position_ = NAN;
+  if (touch_captured_) {
+    // nozzle touched one probe offset away from the point, move it along the mesh
+    left_extruder_auto_probe_position_ = captured_touch_z_ + ProbedHeight(probe_x, probe_y)
+                                          - ProbedHeight(captured_touch_x_, captured_touch_y_);
+    touch_captured_ = false;
+  }
+  if (isnan(left_extruder_auto_probe_position_)) {
+#endif
   do_blocking_move_to_xy(probe_x, probe_y, XY_SPEED_FOR_DUAL_EXTRUDER);
   planner.synchronize();
 
@@ -845,6 +903,9 @@ ErrCode BedLevelService::FinishDualExtruderAutoLeveling(SSTP_Event_t &event) {
   printer1->ModuleCtrlSetExtruderChecking(false);
   left_extruder_auto_probe_position_ = probe_pt(probe_x, probe_y, PROBE_PT_RAISE, 0, false);
   printer1->ModuleCtrlSetExtruderChecking(true);
+#if ENABLED(DUAL_PROBE_CAPTURE)
+  }
+#endif
   if (isnan(left_extruder_auto_probe_position_)) {
     err = E_FAILURE;
     goto EXIT;
@@ -1292,3 +1353,241 @@ ErrCode BedLevelService::FinishDualExtruderManualBedDetect() {
   return E_SUCCESS;
 }
 
+
+#if ENABLED(BED_THERMAL_DRIFT)
+
+ErrCode BedLevelService::ProbeThermalDrift() {
+  ErrCode err = E_SUCCESS;
+  float x[THERMAL_DRIFT_POINTS], y[THERMAL_DRIFT_POINTS], z[THERMAL_DRIFT_POINTS];
+
+  if (MODULE_TOOLHEAD_3DP != ModuleBase::toolhead()) {
+    LOG_E("thermal drift: only probe with 3DP\n");
+    return E_INVALID_STATE;
+  }
+
+  const float temp_start = thermalManager.degBed();
+  const bool leveling = planner.leveling_active;
+
+  AdjustMotionEnv();
+
+  // same Z reference as a job, which homes at this temperature
+  process_cmd_imd("G28");
+
+  set_bed_leveling_enabled(false);
+  bilinear_grid_manual();
+
+  planner.settings.max_feedrate_mm_s[Z_AXIS] = max_speed_in_calibration[Z_AXIS];
+
+  endstops.enable_z_probe(true);
+  do_blocking_move_to_z(15, 10);
+
+  for (uint8_t k = 0; k < THERMAL_DRIFT_POINTS; k++) {
+    ThermalDrift::Point(k, x[k], y[k]);
+    z[k] = probe_pt(x[k], y[k], k < THERMAL_DRIFT_POINTS - 1 ? PROBE_PT_RAISE : PROBE_PT_NONE);
+    if (isnan(z[k])) {
+      LOG_E("thermal drift: probe failed at %.1f, %.1f\n", x[k], y[k]);
+      err = E_AUTO_PROBING;
+      break;
+    }
+    LOG_I("thermal drift: point %u, x: %.1f, y: %.1f, z: %.3f\n", k, x[k], y[k], z[k]);
+  }
+
+  endstops.enable_z_probe(false);
+  do_blocking_move_to_z(current_position[Z_AXIS] + 5, speed_in_calibration[Z_AXIS]);
+
+  RecoverMotionEnv();
+  set_bed_leveling_enabled(leveling);
+
+  if (err == E_SUCCESS)
+    thermal_drift.AddSample((temp_start + thermalManager.degBed()) / 2, x, y, z);
+
+  return err;
+}
+
+#endif // ENABLED(BED_THERMAL_DRIFT)
+
+#if ENABLED(INCREMENTAL_LEVELING)
+
+// next sparse row or column: every step-th one, and the last one
+static uint8_t NextSparse(uint8_t i, uint32_t points, uint8_t step) {
+  return (uint8_t)MIN(i + step, points - 1);
+}
+
+// how far the thermal drift moves the saved mesh at a point now
+static float MeshPointDrift(uint8_t i, uint8_t j) {
+#if ENABLED(BED_THERMAL_DRIFT)
+  return bilinear_drift[0] + bilinear_drift[1] * _GET_MESH_X(i) + bilinear_drift[2] * _GET_MESH_Y(j);
+#else
+  return 0;
+#endif
+}
+
+// probe a mesh point, return how far it moved from the saved mesh
+float BedLevelService::ProbeMeshPoint(uint8_t i, uint8_t j, float margin) {
+  const float expected = z_values[i][j] + nozzle_height_probed + MeshPointDrift(i, j);
+
+#if ENABLED(QUICK_AUTO_PROBING)
+  // start from where the saved mesh expects the trigger, margin covers what moved so far
+  const float z = probe_pt_quick(_GET_MESH_X(i), _GET_MESH_Y(j),
+                                 expected - zprobe_zoffset + QUICK_PROBING_CLEARANCE + margin);
+#else
+  UNUSED(margin);
+  const float z = probe_pt(_GET_MESH_X(i), _GET_MESH_Y(j), PROBE_PT_RAISE);
+#endif
+
+  LOG_I("incremental leveling: point [%u, %u], expect: %.3f, probed: %.3f\n", i, j, expected, z);
+  return z - expected;
+}
+
+// probe the pending points row by row in zigzag, put the changes into z_values_tmp
+ErrCode BedLevelService::ProbePending(bool pending[GRID_MAX_NUM][GRID_MAX_NUM], float &max_change, uint8_t &probed) {
+  bool reverse = false;
+
+  for (uint8_t j = 0; j < GRID_MAX_POINTS_Y; j++) {
+    bool in_row = false;
+
+    for (uint8_t n = 0; n < GRID_MAX_POINTS_X; n++) {
+      const uint8_t i = reverse ? GRID_MAX_POINTS_X - 1 - n : n;
+      if (!pending[i][j])
+        continue;
+
+      const float change = ProbeMeshPoint(i, j, max_change);
+      if (isnan(change))
+        return E_AUTO_PROBING;
+
+      z_values_tmp[i][j] = change;
+      NOLESS(max_change, ABS(change));
+      probed++;
+      in_row = true;
+    }
+
+    if (in_row)
+      reverse = !reverse;
+  }
+
+  return E_SUCCESS;
+}
+
+ErrCode BedLevelService::IncrementalLeveling(float threshold, uint8_t step) {
+  ErrCode err = E_SUCCESS;
+  bool pending[GRID_MAX_NUM][GRID_MAX_NUM];
+  float max_change = 0;
+  uint8_t probed = 0, cells = 0;
+  uint8_t x0, x1, y0, y1;
+
+  if (MODULE_TOOLHEAD_3DP != ModuleBase::toolhead()) {
+    LOG_E("incremental leveling: only with 3DP\n");
+    return E_INVALID_STATE;
+  }
+
+  // the saved mesh is in nozzle height, probed height needs the nozzle height to compare with it
+  if (z_values[0][0] == DEFAUT_LEVELING_HEIGHT || nozzle_height_probed <= 0 ||
+      nozzle_height_probed > MAX_NOZZLE_HEIGHT_PROBED) {
+    LOG_E("incremental leveling: no mesh to start from, nozzle height: %.2f\n", nozzle_height_probed);
+    return E_INVALID_STATE;
+  }
+
+  const bool leveling = planner.leveling_active;
+
+  AdjustMotionEnv();
+
+  process_cmd_imd("G28");
+
+  set_bed_leveling_enabled(false);
+  bilinear_grid_manual();
+
+  planner.settings.max_feedrate_mm_s[Z_AXIS] = max_speed_in_calibration[Z_AXIS];
+
+  endstops.enable_z_probe(true);
+  do_blocking_move_to_z(15, 10);
+
+  for (uint8_t i = 0; i < GRID_MAX_POINTS_X; i++) {
+    for (uint8_t j = 0; j < GRID_MAX_POINTS_Y; j++) {
+      z_values_tmp[i][j] = NAN;
+      pending[i][j] = false;
+    }
+  }
+
+  // sparse points first
+  for (x0 = 0; ; x0 = NextSparse(x0, GRID_MAX_POINTS_X, step)) {
+    for (y0 = 0; ; y0 = NextSparse(y0, GRID_MAX_POINTS_Y, step)) {
+      pending[x0][y0] = true;
+      if (y0 == GRID_MAX_POINTS_Y - 1) break;
+    }
+    if (x0 == GRID_MAX_POINTS_X - 1) break;
+  }
+
+  err = ProbePending(pending, max_change, probed);
+  if (err != E_SUCCESS)
+    goto EXIT;
+
+  // then the points of the cells which have a corner moved
+  for (x0 = 0; x0 < GRID_MAX_POINTS_X - 1; x0 = x1) {
+    x1 = NextSparse(x0, GRID_MAX_POINTS_X, step);
+    for (y0 = 0; y0 < GRID_MAX_POINTS_Y - 1; y0 = y1) {
+      y1 = NextSparse(y0, GRID_MAX_POINTS_Y, step);
+
+      if (ABS(z_values_tmp[x0][y0]) <= threshold && ABS(z_values_tmp[x1][y0]) <= threshold &&
+          ABS(z_values_tmp[x0][y1]) <= threshold && ABS(z_values_tmp[x1][y1]) <= threshold)
+        continue;
+
+      cells++;
+      for (uint8_t i = x0; i <= x1; i++)
+        for (uint8_t j = y0; j <= y1; j++)
+          pending[i][j] = isnan(z_values_tmp[i][j]);
+    }
+  }
+
+  err = ProbePending(pending, max_change, probed);
+  if (err != E_SUCCESS)
+    goto EXIT;
+
+  // points not probed move as the corners of their cell
+  for (x0 = 0; x0 < GRID_MAX_POINTS_X - 1; x0 = x1) {
+    x1 = NextSparse(x0, GRID_MAX_POINTS_X, step);
+    for (y0 = 0; y0 < GRID_MAX_POINTS_Y - 1; y0 = y1) {
+      y1 = NextSparse(y0, GRID_MAX_POINTS_Y, step);
+
+      for (uint8_t i = x0; i <= x1; i++) {
+        for (uint8_t j = y0; j <= y1; j++) {
+          if (!isnan(z_values_tmp[i][j]))
+            continue;
+
+          const float fx = float(i - x0) / (x1 - x0), fy = float(j - y0) / (y1 - y0);
+          const float z0 = z_values_tmp[x0][y0] + (z_values_tmp[x1][y0] - z_values_tmp[x0][y0]) * fx,
+                      z1 = z_values_tmp[x0][y1] + (z_values_tmp[x1][y1] - z_values_tmp[x0][y1]) * fx;
+          z_values_tmp[i][j] = z0 + (z1 - z0) * fy;
+        }
+      }
+    }
+  }
+
+  // the new mesh is at current bed temperature, thermal drift takes it as a new mesh when saved
+  for (uint8_t i = 0; i < GRID_MAX_POINTS_X; i++)
+    for (uint8_t j = 0; j < GRID_MAX_POINTS_Y; j++)
+      z_values[i][j] += MeshPointDrift(i, j) + z_values_tmp[i][j];
+
+  // or the drift is counted twice till thermal drift runs again
+  TERN_(BED_THERMAL_DRIFT, thermal_drift.Bake());
+
+  bed_level_virt_interpolate();
+
+  LOG_I("incremental leveling: probed %u of %u points, %u cells moved, max change: %.3f\n",
+        probed, GRID_MAX_POINTS_X * GRID_MAX_POINTS_Y, cells, max_change);
+
+EXIT:
+  endstops.enable_z_probe(false);
+  do_blocking_move_to_z(current_position[Z_AXIS] + 5, speed_in_calibration[Z_AXIS]);
+
+  RecoverMotionEnv();
+  set_bed_leveling_enabled(leveling);
+
+  if (err == E_SUCCESS)
+    settings.save();
+  else
+    LOG_E("incremental leveling: probe failed, mesh is not changed\n");
+
+  return err;
+}
+
+#endif // ENABLED(INCREMENTAL_LEVELING)
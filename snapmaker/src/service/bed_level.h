@@ -22,6 +22,7 @@
 #define SNAPMAKER_BED_LEVEL_H_
 
 #include "../hmi/event_handler.h"
+#include "thermal_drift.h"
 #include "src/module/ft_motion.h"
 
 enum LevelMode: uint8_t {
@@ -78,9 +79,26 @@ class BedLevelService {
     ErrCode DualExtruderRightExtruderManualBedDetect();
     ErrCode FinishDualExtruderManualBedDetect();
 
+#if ENABLED(BED_THERMAL_DRIFT)
+    // probe the thermal drift points at current bed temperature
+    ErrCode ProbeThermalDrift();
+#endif
+
+#if ENABLED(INCREMENTAL_LEVELING)
+    // probe every step-th point of the mesh, and the cells around those moved more than threshold
+    ErrCode IncrementalLeveling(float threshold, uint8_t step);
+#endif
+
   private:
     void RecoverMotionEnv();
     void AdjustMotionEnv();
+#if ENABLED(DUAL_PROBE_CAPTURE)
+    float ProbedHeight(float x, float y);
+#endif
+#if ENABLED(INCREMENTAL_LEVELING)
+    float ProbeMeshPoint(uint8_t i, uint8_t j, float margin);
+    ErrCode ProbePending(bool pending[GRID_MAX_NUM][GRID_MAX_NUM], float &max_change, uint8_t &probed);
+#endif
 
   private:
     LevelMode level_mode_ = LEVEL_MODE_INVALD;
@@ -93,6 +111,13 @@ class BedLevelService {
     float right_extruder_auto_probe_position_;
     float left_extruder_manual_probe_position_;
     float right_extruder_manual_probe_position_;
+#if ENABLED(DUAL_PROBE_CAPTURE)
+    // left nozzle touch taken with the center point, at nozzle XY
+    bool  touch_captured_ = false;
+    float captured_touch_x_;
+    float captured_touch_y_;
+    float captured_touch_z_;
+#endif
     union {
       float MeshPointZ[GRID_MAX_POINTS];
       float z_values_tmp[GRID_MAX_NUM][GRID_MAX_NUM];
@@ -0,0 +1,261 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "hotend_feedforward.h"
+
+#if ENABLED(HOTEND_FEEDFORWARD)
+
+#include "quick_stop.h"
+#include "../common/debug.h"
+#include "../module/can_host.h"
+#include "../module/module_base.h"
+
+#include "src/Marlin.h"
+#include "src/module/motion.h"
+#include "src/module/planner.h"
+#include "src/module/temperature.h"
+
+HotendFeedForward hotend_ff;
+
+
+void HotendFeedForward::Reset() {
+  for (int e = 0; e < EXTRUDERS; e++) {
+    model[e].heater_power      = HOTEND_FF_HEATER_POWER;
+    model[e].filament_heat_cap = HOTEND_FF_FILAMENT_HEAT_CAP;
+    model[e].ambient           = HOTEND_FF_AMBIENT;
+  }
+}
+
+
+void HotendFeedForward::enable(bool onoff) {
+  enabled_ = onoff;
+  // give the module another chance, it may have been replaced
+  unsupported_ = false;
+}
+
+
+void HotendFeedForward::PlannedFlow(float (&flow)[EXTRUDERS]) {
+  static const float area = M_PI * sq(HOTEND_FF_FILAMENT_DIA) / 4;
+
+  float volume[EXTRUDERS] = { 0 };
+  float seconds = 0;
+
+  // only the stepper ISR may touch the blocks meanwhile, and it just releases them
+  const uint8_t head = planner.block_buffer_head;
+  for (uint8_t i = planner.block_buffer_tail; i != head && seconds < HOTEND_FF_LOOKAHEAD / 1000.0f; i = BLOCK_MOD(i + 1)) {
+    const block_t *block = &planner.block_buffer[i];
+
+    if (TEST(block->flag, BLOCK_BIT_SYNC_POSITION) || block->nominal_speed <= 0)
+      continue;
+
+    seconds += block->millimeters / block->nominal_speed;
+
+    // retraction takes no heat
+    if (!block->steps[E_AXIS] || TEST(block->direction_bits, E_AXIS) || block->extruder >= EXTRUDERS)
+      continue;
+
+    volume[block->extruder] += block->steps[E_AXIS] * planner.steps_to_mm[E_AXIS] * area;
+  }
+
+  for (int e = 0; e < EXTRUDERS; e++)
+    flow[e] = seconds > 0 ? volume[e] / seconds : 0;
+}
+
+
+void HotendFeedForward::Update() {
+  float flow[EXTRUDERS];
+
+  if (!enabled_ || unsupported_ || PENDING(millis(), next_update_ms_))
+    return;
+
+  next_update_ms_ = millis() + HOTEND_FF_INTERVAL;
+
+  PlannedFlow(flow);
+  for (int e = 0; e < EXTRUDERS; e++)
+    planned_flow_[e] = flow[e];
+  planned_ms_ = millis();
+}
+
+
+void HotendFeedForward::Process() {
+  CanStdFuncCmd_t cmd;
+  uint8_t buffer[2 * EXTRUDERS];
+  float flow[EXTRUDERS];
+  uint8_t hotends;
+  bool active = false;
+
+  if (!enabled_ || unsupported_ || PENDING(millis(), next_ms_))
+    return;
+
+  next_ms_ = millis() + HOTEND_FF_INTERVAL;
+
+  switch (ModuleBase::toolhead()) {
+  case MODULE_TOOLHEAD_3DP:
+    hotends = 1;
+    break;
+
+  case MODULE_TOOLHEAD_DUALEXTRUDER:
+    hotends = 2;
+    break;
+
+  default:
+    return;
+  }
+
+  // Marlin task is blocked somewhere without idle(), don't trust the old flow
+  const bool fresh = millis() - planned_ms_ < 2 * HOTEND_FF_INTERVAL;
+  for (uint8_t e = 0; e < hotends; e++)
+    flow[e] = fresh ? planned_flow_[e] : 0;
+
+  for (uint8_t e = 0; e < hotends; e++) {
+    const HotendModel_t &m = model[e];
+    const int16_t target = thermalManager.degTargetHotend(e);
+
+    flow_[e]  = flow[e];
+    power_[e] = target > m.ambient ? flow[e] * m.filament_heat_cap * (target - m.ambient) : 0;
+    NOMORE(power_[e], m.heater_power);
+
+    // 0.1 W
+    const uint16_t hint = (uint16_t)(power_[e] * 10);
+    if (hint || last_hint_[e])
+      active = true;
+    last_hint_[e] = hint;
+
+    buffer[2*e + 0] = (uint8_t)(hint>>8);
+    buffer[2*e + 1] = (uint8_t)hint;
+  }
+
+  // keep refreshing while extruding, and send the last zero once
+  if (!active)
+    return;
+
+  cmd.id     = MODULE_FUNC_SET_HEATER_FEEDFORWARD;
+  cmd.data   = buffer;
+  cmd.length = 2 * hotends;
+
+  if (canhost.SendStdCmd(cmd, 0) == E_PARAM) {
+    LOG_I("toolhead doesn't take feed-forward power\n");
+    unsupported_ = true;
+  }
+}
+
+
+// time the hotend crossed temp, 0 if it didn't in time
+static millis_t WaitCrossing(uint8_t e, float temp, bool rising, millis_t timeout) {
+  const millis_t end = millis() + timeout;
+
+  while (rising ? thermalManager.degHotend(e) < temp : thermalManager.degHotend(e) > temp) {
+    if (ELAPSED(millis(), end) || quickstop.isTriggered())
+      return 0;
+    idle();
+  }
+
+  #if ENABLED(HOTEND_TEMP_TELEMETRY)
+    // when the sample arrived, not when we looked at it
+    return millis() - printer1->GetTempAge(e);
+  #else
+    return millis();
+  #endif
+}
+
+
+/**
+ * Cold block gives the ambient the filament comes in at.
+ * Heat from ambient: the module PID is saturated at first, so the slope is
+ * the full heater power over the heat capacity of the block.
+ * Soak at target, then extrude HOTEND_FF_CAL_FLOW with feed-forward off: the
+ * first slope of the dip, before the PID catches up, is the melt power over
+ * the same heat capacity. Ratio of the slopes gives H against heater power.
+ * Heater power isn't visible from temperature alone, it stays the rated one.
+ * Module takes the hint as a share of that same rated power, so H measured
+ * against it gives the right duty even if the real heater is off the rating.
+ */
+ErrCode HotendFeedForward::Calibrate(int16_t target) {
+  static const float area = M_PI * sq(HOTEND_FF_FILAMENT_DIA) / 4;
+  const uint8_t e = active_extruder;
+  HotendModel_t &m = model[e];
+  const bool was_enabled = enabled_;
+  millis_t ms_lo, ms_hi;
+  float heat_slope, dip_slope;
+
+  const float ambient = thermalManager.degHotend(e);
+
+  if (ambient > 50) {
+    LOG_E("M306: hotend %u at %.1f, let it cool down first\n", e, ambient);
+    return E_BUSY;
+  }
+
+  if (target < ambient + 80 || target < EXTRUDE_MINTEMP) {
+    LOG_E("M306: target %d is too low\n", target);
+    return E_PARAM;
+  }
+
+  SERIAL_ECHOLNPAIR("M306: heating T", e, " to ", target);
+  thermalManager.setTargetHotend(target, e);
+
+  ms_lo = WaitCrossing(e, ambient + 10, true, 120000);
+  ms_hi = ms_lo ? WaitCrossing(e, ambient + 40, true, 120000) : 0;
+  if (!ms_hi || ms_hi == ms_lo)
+    goto fail;
+
+  // (°C/ms)
+  heat_slope = 30.0f / (ms_hi - ms_lo);
+
+  // let the block soak at target
+  if (!WaitCrossing(e, target - 1, true, 300000))
+    goto fail;
+  for (millis_t end = millis() + 20000; PENDING(millis(), end); idle())
+    if (quickstop.isTriggered()) goto fail;
+
+  SERIAL_ECHOLNPGM("M306: extruding");
+  enabled_ = false;
+
+  // 20s of extrusion, the dip shows within the first seconds
+  current_position[E_AXIS] += HOTEND_FF_CAL_FLOW / area * 20;
+  line_to_current_position(HOTEND_FF_CAL_FLOW / area);
+
+  ms_hi = WaitCrossing(e, target - 1, false, 20000);
+  ms_lo = ms_hi ? WaitCrossing(e, target - 3, false, 20000) : 0;
+  planner.synchronize();
+  enabled_ = was_enabled;
+  if (!ms_lo || ms_hi == ms_lo) {
+    SERIAL_ECHOLNPGM("M306: no dip, is filament loaded?");
+    goto fail;
+  }
+
+  dip_slope = 2.0f / (ms_lo - ms_hi);
+
+  m.ambient           = ambient;
+  m.filament_heat_cap = m.heater_power * dip_slope / (heat_slope * HOTEND_FF_CAL_FLOW * (target - 2 - ambient));
+
+  thermalManager.setTargetHotend(0, e);
+  SERIAL_ECHOLNPAIR("M306 E", e, " P", m.heater_power, " H", m.filament_heat_cap, " R", m.ambient);
+  SERIAL_ECHOLNPGM("M306: M500 to save");
+  return E_SUCCESS;
+
+fail:
+  planner.synchronize();
+  enabled_ = was_enabled;
+  thermalManager.setTargetHotend(0, e);
+  SERIAL_ECHOLNPGM("M306: calibration failed");
+  return E_FAILURE;
+}
+
+#endif // ENABLED(HOTEND_FEEDFORWARD)
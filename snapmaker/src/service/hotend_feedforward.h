@@ -0,0 +1,89 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SNAPMAKER_HOTEND_FEEDFORWARD_H_
+#define SNAPMAKER_HOTEND_FEEDFORWARD_H_
+
+#include "../common/config.h"
+#include "../common/error.h"
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(HOTEND_FEEDFORWARD)
+
+#include "../module/toolhead_3dp.h"
+
+typedef struct {
+  float heater_power;       // (W)
+  float filament_heat_cap;  // (J/K/mm³)
+  float ambient;            // (°C) filament comes in at
+} HotendModel_t;
+
+
+class HotendFeedForward {
+  public:
+    HotendFeedForward() { Reset(); }
+
+    void Reset();
+
+    // called by Marlin task in idle(), take the flow of the queued blocks
+    void Update();
+
+    // called by CAN task, send the power hint every HOTEND_FF_INTERVAL
+    void Process();
+
+    // called by Marlin task, blocks until the model of active hotend is measured
+    ErrCode Calibrate(int16_t target);
+
+    // power to melt the queued extrusion of hotend e, (W)
+    float power(uint8_t e) { return power_[e]; }
+    // volumetric flow of the queued extrusion of hotend e, (mm³/s)
+    float flow(uint8_t e) { return flow_[e]; }
+
+    bool enabled() { return enabled_; }
+    void enable(bool onoff);
+
+  public:
+    HotendModel_t model[EXTRUDERS];  // saved by M500
+
+  private:
+    // average flow of each hotend over the next HOTEND_FF_LOOKAHEAD of queued motion
+    void PlannedFlow(float (&flow)[EXTRUDERS]);
+
+  private:
+    bool enabled_ = true;
+    bool unsupported_ = false;  // module didn't register the function
+    millis_t next_ms_ = 0;
+
+    // taken by Marlin task, which owns the planner blocks, for CAN task
+    volatile float planned_flow_[EXTRUDERS] = { 0 };
+    volatile millis_t planned_ms_ = 0;
+    millis_t next_update_ms_ = 0;
+
+    float flow_[EXTRUDERS] = { 0 };
+    float power_[EXTRUDERS] = { 0 };
+    uint16_t last_hint_[EXTRUDERS] = { 0 };
+};
+
+extern HotendFeedForward hotend_ff;
+
+#endif // ENABLED(HOTEND_FEEDFORWARD)
+
+#endif // #ifndef SNAPMAKER_HOTEND_FEEDFORWARD_H_
@@ -0,0 +1,265 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "idle_nozzle_preheat.h"
+
+#if ENABLED(IDLE_NOZZLE_PREHEAT)
+
+#include "system.h"
+#include "quick_stop.h"
+#include "../common/debug.h"
+#include "../hmi/event_handler.h"
+#include "../module/module_base.h"
+
+#include "src/Marlin.h"
+#include "src/gcode/queue.h"
+#include "src/module/motion.h"
+#include "src/module/planner.h"
+#include "src/module/temperature.h"
+
+IdleNozzlePreheat nozzle_preheat;
+
+
+// parse a number at p, the packed G-code is not null-terminated so stop at end
+static float ReadNumber(const char *&p, const char *end) {
+  bool neg = false;
+  float val = 0, scale = 0;
+
+  if (p < end && (*p == '-' || *p == '+'))
+    neg = (*p++ == '-');
+
+  for (; p < end; p++) {
+    if (*p >= '0' && *p <= '9') {
+      if (scale == 0) {
+        val = val * 10 + (*p - '0');
+      }
+      else {
+        val += (*p - '0') * scale;
+        scale *= 0.1f;
+      }
+    }
+    else if (*p == '.' && scale == 0) {
+      scale = 0.1f;
+    }
+    else {
+      break;
+    }
+  }
+
+  return neg ? -val : val;
+}
+
+
+int8_t IdleNozzlePreheat::ScanLine(const char *p, const char *end) {
+  char code = 0;
+  int16_t num = -1;
+  float target[XYZ];
+  float dwell = 0;
+
+  COPY(target, scan_pos_);
+
+  while (p < end && *p != '\0' && *p != '\n' && *p != ';') {
+    char c = *p++;
+    if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+    if (c < 'A' || c > 'Z') continue;
+
+    const float val = ReadNumber(p, end);
+
+    if (!code) {
+      // line number is not a command
+      if (c == 'N') continue;
+
+      code = c;
+      num = (int16_t)val;
+      if (code == 'T') return (int8_t)num;
+      if (code == 'G' && num == 90) scan_relative_ = false;
+      if (code == 'G' && num == 91) scan_relative_ = true;
+      continue;
+    }
+
+    if (code != 'G') break;
+
+    switch (c) {
+    case 'X': case 'Y': case 'Z': {
+      const uint8_t axis = c - 'X';
+      if (num == 92)
+        scan_pos_[axis] = target[axis] = val;
+      else
+        target[axis] = scan_relative_ ? scan_pos_[axis] + val : val;
+      break;
+    }
+
+    case 'F':
+      if (num <= 3 && val > 0) scan_feed_ = MMM_TO_MMS(val);
+      break;
+
+    case 'P':
+      if (num == 4) dwell = val / 1000;
+      break;
+
+    case 'S':
+      if (num == 4) dwell = val;
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  if (code == 'G' && num >= 0 && num <= 3) {
+    // arcs are taken as their chord, that only makes the swap look earlier
+    const float mm = SQRT(sq(target[X_AXIS] - scan_pos_[X_AXIS]) +
+                          sq(target[Y_AXIS] - scan_pos_[Y_AXIS]) +
+                          sq(target[Z_AXIS] - scan_pos_[Z_AXIS]));
+    scan_eta_ += mm / scan_feed_;
+    COPY(scan_pos_, target);
+  }
+  else if (code == 'G' && num == 4) {
+    scan_eta_ += dwell;
+  }
+
+  return -1;
+}
+
+
+float IdleNozzlePreheat::ScanQueues(uint8_t e) {
+  LOOP_XYZ(i) scan_pos_[i] = current_position[i];
+  scan_feed_ = feedrate_mm_s > 0 ? feedrate_mm_s : 1;
+  scan_relative_ = relative_mode;
+  scan_eta_ = 0;
+
+  // commands Marlin has fetched but not executed yet
+  for (uint8_t i = 0; i < commands_in_queue; i++) {
+    const char *cmd = command_queue[(cmd_queue_index_r + i) % BUFSIZE];
+    if (ScanLine(cmd, cmd + MAX_CMD_SIZE) == e)
+      goto found;
+  }
+
+  // then the packs from HMI, the head is being consumed from its cursor
+  for (int32_t n = 0; ; n++) {
+    HmiGcodeBufNode_t *node = hmi_gcode_pack_buffer.PeekAddress(n);
+    if (!node || node->is_finish_packet)
+      return -1;
+
+    const char *end = node->buf + node->length;
+    for (const char *p = node->buf + (n ? 0 : node->cursor); p < end; p++) {
+      if (ScanLine(p, end) == e)
+        goto found;
+
+      while (p < end && *p != '\n' && *p != '\0') p++;
+    }
+  }
+
+found:
+  return scan_eta_ * 100 / feedrate_percentage;
+}
+
+
+void IdleNozzlePreheat::Reset() {
+  LOOP_L_N(e, EXTRUDERS) {
+    print_temp_[e] = 0;
+    last_set_[e] = 0;
+  }
+}
+
+
+void IdleNozzlePreheat::Process() {
+  if (!enabled_ || PENDING(millis(), next_tick_))
+    return;
+
+  next_tick_ = millis() + IDLE_NOZZLE_PREHEAT_INTERVAL;
+
+  const SysStatus status = systemservice.GetCurrentStatus();
+
+  if (ModuleBase::toolhead() != MODULE_TOOLHEAD_DUALEXTRUDER ||
+      status < SYSTAT_WORK || status >= SYSTAT_END_TRIG) {
+    // learn the temperatures again in next job
+    Reset();
+    return;
+  }
+
+  // paused or resuming, keep what we learned, pause and resume own the targets now
+  if (status != SYSTAT_WORK || quickstop.isTriggered())
+    return;
+
+  const uint8_t active = active_extruder;
+  if (thermalManager.degTargetHotend(active) >= EXTRUDE_MINTEMP)
+    print_temp_[active] = thermalManager.degTargetHotend(active);
+  last_set_[active] = thermalManager.degTargetHotend(active);
+
+  LOOP_L_N(e, EXTRUDERS) {
+    if (e == active)
+      continue;
+
+    const int16_t target = thermalManager.degTargetHotend(e);
+
+    // G-code raised the idle nozzle by itself, take it as its new print temperature
+    if (target != last_set_[e] && target >= EXTRUDE_MINTEMP && target > print_temp_[e] - standby_drop)
+      print_temp_[e] = target;
+
+    // never worked in this job, nothing to keep warm
+    if (print_temp_[e] < EXTRUDE_MINTEMP) {
+      last_set_[e] = target;
+      continue;
+    }
+
+    const float eta = ScanQueues(e);
+    const float lead = (print_temp_[e] - thermalManager.degHotend(e)) / heat_rate + margin;
+
+    int16_t want;
+    if (eta >= 0 && eta + planner.block_buffer_runtime() / 1000.0f <= lead)
+      want = print_temp_[e];
+    else if (target == 0)
+      want = 0;  // turned off by G-code
+    else
+      want = _MIN(target, print_temp_[e] - standby_drop);
+
+    if (want != target) {
+      LOG_I("idle nozzle %u: %d -> %d, swap in %.1f s\n", e, target, want, eta);
+      thermalManager.setTargetHotend(want, e);
+    }
+    last_set_[e] = want;
+  }
+}
+
+void IdleNozzlePreheat::PrepareSwap(uint8_t e) {
+  if (e >= EXTRUDERS || print_temp_[e] < EXTRUDE_MINTEMP)
+    return;
+
+  const int16_t target = thermalManager.degTargetHotend(e);
+
+  // G-code set or turned off the nozzle by itself, leave it
+  if (target == 0 || target != last_set_[e])
+    return;
+
+  if (target < print_temp_[e]) {
+    LOG_I("idle nozzle %u: %d -> %d for swap\n", e, target, print_temp_[e]);
+    thermalManager.setTargetHotend(print_temp_[e], e);
+    last_set_[e] = print_temp_[e];
+  }
+
+  // preheat was late, don't extrude with a cold nozzle
+  if (thermalManager.degHotend(e) < print_temp_[e] - TEMP_WINDOW) {
+    LOG_I("idle nozzle %u: wait for %d, now %.1f\n", e, print_temp_[e], thermalManager.degHotend(e));
+    thermalManager.wait_for_hotend(e);
+  }
+}
+
+#endif // ENABLED(IDLE_NOZZLE_PREHEAT)
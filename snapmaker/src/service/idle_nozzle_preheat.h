@@ -0,0 +1,74 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2023 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SNAPMAKER_IDLE_NOZZLE_PREHEAT_H_
+#define SNAPMAKER_IDLE_NOZZLE_PREHEAT_H_
+
+#include "../common/config.h"
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(IDLE_NOZZLE_PREHEAT)
+
+#define IDLE_NOZZLE_PREHEAT_INTERVAL  500  // (ms)
+
+class IdleNozzlePreheat {
+  public:
+    // called by Marlin task, between two commands
+    void Process();
+
+    // called by tool change, before the nozzle e is used
+    void PrepareSwap(uint8_t e);
+
+    bool enabled() { return enabled_; }
+    void enable(bool onoff) { enabled_ = onoff; }
+
+  public:
+    int16_t standby_drop = IDLE_NOZZLE_STANDBY_DROP;  // (°C)
+    float heat_rate = IDLE_NOZZLE_HEAT_RATE;          // (°C/s)
+    float margin = IDLE_NOZZLE_HEAT_MARGIN;           // (s)
+
+  private:
+    void Reset();
+
+    // seconds of motion before the next swap to tool e in the queued G-code, -1 if not found
+    float ScanQueues(uint8_t e);
+    // add the time of one line to scan_eta_, return the tool it selects or -1
+    int8_t ScanLine(const char *p, const char *end);
+
+  private:
+    bool enabled_ = IDLE_NOZZLE_PREHEAT_ENABLED;
+    millis_t next_tick_ = 0;
+
+    int16_t print_temp_[EXTRUDERS] = { 0 };   // learned while the nozzle was working
+    int16_t last_set_[EXTRUDERS] = { 0 };     // target we set, to find changes made by G-code
+
+    // state of the lookahead
+    float scan_pos_[XYZ];
+    float scan_feed_;
+    bool  scan_relative_;
+    float scan_eta_;
+};
+
+extern IdleNozzlePreheat nozzle_preheat;
+
+#endif // ENABLED(IDLE_NOZZLE_PREHEAT)
+
+#endif // #ifndef SNAPMAKER_IDLE_NOZZLE_PREHEAT_H_
@@ -0,0 +1,182 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "job_align.h"
+
+#if ENABLED(JOB_ALIGNMENT)
+
+#include "../common/debug.h"
+#include "../module/module_base.h"
+#include "../module/toolhead_laser.h"
+
+#include "src/module/motion.h"
+#include "src/module/planner.h"
+
+JobAlign job_align;
+
+// marks closer than this can't give the angle well
+#define JOB_ALIGN_MIN_SPAN  10.0f
+
+
+void JobAlign::Reset() {
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.crosslight_mac = MODULE_MAC_ID_INVALID;
+  cfg.crosslight[X_AXIS] = cfg.crosslight[Y_AXIS] = INVALID_OFFSET;
+}
+
+
+void JobAlign::Apply(bool active) {
+  planner.synchronize();
+
+  // where the head is in machine XY, with the transform in use
+  planner.align(current_position);
+
+  planner.job_transform.active = active;
+  if (active) {
+    planner.job_transform.cos_r = cos(RADIANS(angle_));
+    planner.job_transform.sin_r = sin(RADIANS(angle_));
+    LOOP_L_N(i, XY) {
+      planner.job_transform.center[i] = center_[i];
+      planner.job_transform.offset[i] = offset_[i];
+    }
+  }
+
+  // and in job XY with the new one
+  planner.unalign(current_position);
+  sync_plan_position();
+}
+
+
+void JobAlign::Set(float angle, float cx, float cy, float ox, float oy) {
+  angle_ = angle;
+  center_[X_AXIS] = cx;
+  center_[Y_AXIS] = cy;
+  offset_[X_AXIS] = ox;
+  offset_[Y_AXIS] = oy;
+  enabled_ = true;
+  LOG_I("job alignment: %.3f deg about (%.3f, %.3f), offset (%.3f, %.3f)\n", angle, cx, cy, ox, oy);
+  Apply(true);
+}
+
+
+void JobAlign::Clear() {
+  enabled_ = false;
+  marks_ = 0;
+  Apply(false);
+}
+
+
+ErrCode JobAlign::SetMark(uint8_t k, float x, float y, float mx, float my) {
+  if (k >= JOB_ALIGN_MARKS)
+    return E_PARAM;
+
+  if (k > 0 && !TEST(marks_, 0)) {
+    LOG_E("job alignment: find mark 0 first\n");
+    return E_PARAM;
+  }
+
+  if (k == 0)
+    marks_ = 0;
+
+  job_[k][X_AXIS] = x;
+  job_[k][Y_AXIS] = y;
+  machine_[k][X_AXIS] = mx;
+  machine_[k][Y_AXIS] = my;
+  SBI(marks_, k);
+
+  // one mark moves the job, the second one turns it about the first
+  float angle = 0;
+  if (k > 0) {
+    const float jx = job_[k][X_AXIS] - job_[0][X_AXIS], jy = job_[k][Y_AXIS] - job_[0][Y_AXIS],
+                mx1 = machine_[k][X_AXIS] - machine_[0][X_AXIS], my1 = machine_[k][Y_AXIS] - machine_[0][Y_AXIS];
+    const float span = HYPOT(jx, jy);
+
+    if (span < JOB_ALIGN_MIN_SPAN) {
+      LOG_E("job alignment: marks are %.3f mm apart, need %.1f mm\n", span, JOB_ALIGN_MIN_SPAN);
+      CBI(marks_, k);
+      return E_PARAM;
+    }
+
+    // workpiece may not be the size of the design, or a mark was missed
+    LOG_I("job alignment: marks span %.3f mm in job, %.3f mm found\n", span, HYPOT(mx1, my1));
+
+    angle = DEGREES(ATAN2(my1, mx1) - ATAN2(jy, jx));
+    if (angle > 180) angle -= 360;
+    else if (angle <= -180) angle += 360;
+  }
+
+  Set(angle, job_[0][X_AXIS], job_[0][Y_AXIS],
+      machine_[0][X_AXIS] - job_[0][X_AXIS], machine_[0][Y_AXIS] - job_[0][Y_AXIS]);
+
+  return E_SUCCESS;
+}
+
+
+bool JobAlign::CameraToMachine(float u, float v, float &mx, float &my) {
+  if (!cfg.camera_valid)
+    return false;
+
+  mx = current_position[X_AXIS];
+  my = current_position[Y_AXIS];
+  planner.align(mx, my);
+
+  mx += cfg.camera[0] * u + cfg.camera[1] * v + cfg.camera[2];
+  my += cfg.camera[3] * u + cfg.camera[4] * v + cfg.camera[5];
+  return true;
+}
+
+
+bool JobAlign::Suspend() {
+  if (!planner.job_transform.active)
+    return false;
+
+  Apply(false);
+  return true;
+}
+
+
+void JobAlign::Resume() {
+  if (enabled_)
+    Apply(true);
+}
+
+
+void JobAlign::CacheCrossLight(uint32_t mac, float x, float y) {
+  if (mac == cfg.crosslight_mac && x == cfg.crosslight[X_AXIS] && y == cfg.crosslight[Y_AXIS])
+    return;
+
+  cfg.crosslight_mac = mac;
+  cfg.crosslight[X_AXIS] = x;
+  cfg.crosslight[Y_AXIS] = y;
+  // no flash write here, it is reached from start and resume of a job, M500 saves it
+  LOG_I("crosslight offset of module 0x%08X cached\n", mac);
+}
+
+
+bool JobAlign::CachedCrossLight(uint32_t mac, float &x, float &y) {
+  if (mac == MODULE_MAC_ID_INVALID || mac != cfg.crosslight_mac)
+    return false;
+
+  x = cfg.crosslight[X_AXIS];
+  y = cfg.crosslight[Y_AXIS];
+  return true;
+}
+
+#endif // ENABLED(JOB_ALIGNMENT)
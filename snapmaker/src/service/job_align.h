@@ -0,0 +1,95 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SNAPMAKER_JOB_ALIGN_H_
+#define SNAPMAKER_JOB_ALIGN_H_
+
+#include "../common/config.h"
+#include "../common/error.h"
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(JOB_ALIGNMENT)
+
+#define JOB_ALIGN_MARKS  2
+
+// calibrations kept in EEPROM
+typedef struct {
+  // camera pixel (u, v) to machine XY, relative to the head when the image was taken:
+  //   x = a[0] * u + a[1] * v + a[2]
+  //   y = a[3] * u + a[4] * v + a[5]
+  float    camera[6];
+  bool     camera_valid;
+  uint32_t crosslight_mac;  // laser module the offset was read from
+  float    crosslight[XY];  // (mm)
+} job_align_cfg_t;
+
+class JobAlign {
+  public:
+    void Reset();
+
+    // rotate the job by angle (°) about center, then move it by offset, in machine XY
+    void Set(float angle, float cx, float cy, float ox, float oy);
+    void Clear();
+
+    // reference mark k is at job (x, y), and found at machine (mx, my)
+    ErrCode SetMark(uint8_t k, float x, float y, float mx, float my);
+
+    // machine XY of a camera pixel, from the current head position
+    bool CameraToMachine(float u, float v, float &mx, float &my);
+
+    // called by G28, home in machine XY
+    bool Suspend();
+    void Resume();
+
+    // called when the laser module gives its crosslight offset, kept in RAM till M500
+    void CacheCrossLight(uint32_t mac, float x, float y);
+    // offset of the module last seen, if it doesn't answer
+    bool CachedCrossLight(uint32_t mac, float &x, float &y);
+
+    bool enabled() { return enabled_; }
+    float angle() { return angle_; }
+    float center(uint8_t i) { return center_[i]; }
+    float offset(uint8_t i) { return offset_[i]; }
+    uint8_t marks() { return marks_; }
+
+  public:
+    job_align_cfg_t cfg;  // saved by M500
+
+  private:
+    // keep the head where it is while the transform changes
+    void Apply(bool active);
+
+  private:
+    float angle_ = 0;
+    float center_[XY];
+    float offset_[XY];
+    bool  enabled_ = false;  // set by M1040, stays over G28
+
+    uint8_t marks_ = 0;  // bit k: mark k was found
+    float job_[JOB_ALIGN_MARKS][XY];
+    float machine_[JOB_ALIGN_MARKS][XY];
+};
+
+extern JobAlign job_align;
+
+#endif // ENABLED(JOB_ALIGNMENT)
+
+#endif // #ifndef SNAPMAKER_JOB_ALIGN_H_
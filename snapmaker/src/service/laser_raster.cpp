@@ -0,0 +1,150 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2023 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "laser_raster.h"
+
+#if ENABLED(LASER_RASTER_MODE)
+
+#include "quick_stop.h"
+#include "../common/debug.h"
+#include "../hmi/event_handler.h"
+
+#include "src/Marlin.h"
+
+LaserRaster laser_raster;
+
+
+void LaserRaster::Reset() {
+  // HMI task may be copying a chunk, it sees the new epoch and drops it
+  taskENTER_CRITICAL();
+  for (uint8_t i = 0; i < LASER_RASTER_SLOTS; i++) {
+    slots_[i].state = LASER_RASTER_SLOT_FREE;
+    slots_[i].received = 0;
+  }
+  fill_ = 0;
+  take_ = 0;
+  epoch_++;
+  taskEXIT_CRITICAL();
+}
+
+
+ErrCode LaserRaster::ReceiveData(SSTP_Event_t &event) {
+  ErrCode err = E_SUCCESS;
+  uint16_t line, pixels, offset, count;
+  uint8_t index, epoch;
+
+  if (event.length < 6) {
+    LOG_E("raster: no line header\n");
+    err = E_PARAM;
+    goto out;
+  }
+
+  PDU_TO_LOCAL_HALF_WORD(line, event.data);
+  PDU_TO_LOCAL_HALF_WORD(pixels, event.data + 2);
+  PDU_TO_LOCAL_HALF_WORD(offset, event.data + 4);
+  count = event.length - 6;
+
+  if (pixels == 0 || pixels > LASER_RASTER_MAX_PIXELS || offset + count > pixels) {
+    LOG_E("raster: line %u, invalid range %u + %u / %u\n", line, offset, count, pixels);
+    err = E_PARAM;
+    goto out;
+  }
+
+  taskENTER_CRITICAL();
+  index = fill_;
+  epoch = epoch_;
+  {
+    LaserRasterSlot_t &slot = slots_[index];
+
+    // host should retry later, the stepper is still burning the lines before
+    if (slot.state != LASER_RASTER_SLOT_FREE) {
+      err = E_BUSY;
+    }
+    // first chunk of a line, or host restarted the line
+    else if (offset == 0) {
+      slot.line = line;
+      slot.pixels = pixels;
+      slot.received = 0;
+    }
+    else if (slot.line != line || slot.pixels != pixels || slot.received != offset) {
+      err = E_PARAM;
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  if (err == E_PARAM)
+    LOG_E("raster: line %u, chunk at %u out of order\n", line, offset);
+  if (err != E_SUCCESS)
+    goto out;
+
+  // only this task writes a free slot, so copy it without the lock
+  memcpy(slots_[index].pwm + offset, event.data + 6, count);
+
+  taskENTER_CRITICAL();
+  if (epoch != epoch_) {
+    // lines were dropped by quick stop while copying
+    err = E_FAILURE;
+  }
+  else {
+    LaserRasterSlot_t &slot = slots_[index];
+
+    slot.received += count;
+    if (slot.received == slot.pixels) {
+      slot.state = LASER_RASTER_SLOT_READY;
+      fill_ = (fill_ + 1) % LASER_RASTER_SLOTS;
+    }
+  }
+  taskEXIT_CRITICAL();
+
+out:
+  event.data   = &err;
+  event.length = 1;
+  return hmi.Send(event);
+}
+
+
+uint8_t LaserRaster::TakeLine(uint16_t line, uint16_t pixels) {
+  LaserRasterSlot_t &slot = slots_[take_];
+  millis_t timeout = millis() + LASER_RASTER_DATA_TIMEOUT;
+
+  while (slot.state != LASER_RASTER_SLOT_READY) {
+    if (quickstop.isTriggered() || ELAPSED(millis(), timeout)) {
+      LOG_E("raster: no data for line %u\n", line);
+      return LASER_RASTER_SLOT_NONE;
+    }
+    idle();
+  }
+
+  if (slot.line != line || slot.pixels != pixels) {
+    LOG_E("raster: expect line %u with %u pixels, got line %u with %u\n", line, pixels, slot.line, slot.pixels);
+    // drop it, or all lines after it will mismatch
+    slot.state = LASER_RASTER_SLOT_FREE;
+    take_ = (take_ + 1) % LASER_RASTER_SLOTS;
+    return LASER_RASTER_SLOT_NONE;
+  }
+
+  uint8_t index = take_;
+  slot.state = LASER_RASTER_SLOT_PLANNED;
+  take_ = (take_ + 1) % LASER_RASTER_SLOTS;
+
+  return index;
+}
+
+#endif // ENABLED(LASER_RASTER_MODE)
@@ -0,0 +1,79 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2023 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SNAPMAKER_LASER_RASTER_H_
+#define SNAPMAKER_LASER_RASTER_H_
+
+#include "../common/config.h"
+#include "../common/error.h"
+#include "../common/protocol_sstp.h"
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(LASER_RASTER_MODE)
+
+#define LASER_RASTER_SLOT_NONE  0xFF
+
+// each slot is handed over HMI task -> Marlin task -> stepper ISR -> HMI task
+enum LaserRasterSlotState: uint8_t {
+  LASER_RASTER_SLOT_FREE,     // HMI task may fill it
+  LASER_RASTER_SLOT_READY,    // all pixels received, waiting for G7
+  LASER_RASTER_SLOT_PLANNED,  // referenced by a planner block, freed by the stepper ISR
+
+  LASER_RASTER_SLOT_INVALID
+};
+
+typedef struct {
+  volatile LaserRasterSlotState state;
+  uint16_t line;      // line number given by host, G7 checks it
+  uint16_t pixels;
+  uint16_t received;
+  uint8_t  pwm[LASER_RASTER_MAX_PIXELS];  // 0 - 255 from host, G7 maps it through the power table
+} LaserRasterSlot_t;
+
+
+class LaserRaster {
+  public:
+    // callback for HMI event, payload: line(2), pixels(2), offset(2), pwm bytes
+    ErrCode ReceiveData(SSTP_Event_t &event);
+
+    // called by G7, wait for the pixels of the line and take its slot
+    uint8_t TakeLine(uint16_t line, uint16_t pixels);
+
+    // drop all lines, after the planner was cleaned, safe against ReceiveData()
+    void Reset();
+
+    // called by G7 before the slot is planned, and by stepper ISR
+    uint8_t *pwm(uint8_t slot) { return slots_[slot].pwm; }
+    uint16_t pixels(uint8_t slot) { return slots_[slot].pixels; }
+    void Release(uint8_t slot) { slots_[slot].state = LASER_RASTER_SLOT_FREE; }
+
+  private:
+    LaserRasterSlot_t slots_[LASER_RASTER_SLOTS];
+    uint8_t fill_;  // slot HMI task is filling
+    uint8_t take_;  // slot G7 will take
+    volatile uint8_t epoch_;  // bumped by Reset(), chunk copied before it is dropped
+};
+
+extern LaserRaster laser_raster;
+
+#endif // ENABLED(LASER_RASTER_MODE)
+
+#endif // #ifndef SNAPMAKER_LASER_RASTER_H_
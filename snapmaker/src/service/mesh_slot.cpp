@@ -0,0 +1,226 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "mesh_slot.h"
+
+#if ENABLED(LEVELING_MESH_SLOTS)
+
+#include "../common/debug.h"
+#include "../module/module_base.h"
+#include "thermal_drift.h"
+
+#include "src/module/planner.h"
+#include "src/module/temperature.h"
+#include "src/feature/bedlevel/bedlevel.h"
+
+MeshSlot mesh_slot;
+
+
+void MeshSlot::Reset() {
+  for (uint8_t i = 0; i < MESH_SLOT_NUM; i++)
+    Clear(i);
+
+  bed_ = 0;
+  active_ = MESH_SLOT_NONE;
+}
+
+
+void MeshSlot::Clear(uint8_t i) {
+  if (i >= MESH_SLOT_NUM)
+    return;
+
+  memset(&slot[i], 0, sizeof(mesh_slot_t));
+  slot[i].toolhead = MODULE_TOOLHEAD_UNKNOW;
+
+  if (active_ == i)
+    active_ = MESH_SLOT_NONE;
+}
+
+
+bool MeshSlot::MeshValid() {
+  return (z_values[0][0] != DEFAUT_LEVELING_HEIGHT) && (z_values[0][0] != DEFAUT_LEVELING_HEIGHT_3DP2E);
+}
+
+
+void MeshSlot::SetTime(uint32_t seconds) {
+  time_base_ = seconds;
+  time_base_ms_ = millis();
+}
+
+
+uint32_t MeshSlot::time() {
+  if (!time_base_)
+    return 0;
+
+  return time_base_ + (millis() - time_base_ms_) / 1000;
+}
+
+
+uint8_t MeshSlot::Find(uint8_t toolhead, uint8_t bed) {
+  for (uint8_t i = 0; i < MESH_SLOT_NUM; i++)
+    if (slot[i].toolhead == toolhead && slot[i].bed == bed)
+      return i;
+
+  return MESH_SLOT_NONE;
+}
+
+
+void MeshSlot::Capture() {
+  const uint8_t toolhead = ModuleBase::toolhead();
+
+  // only printing toolheads level the bed
+  if (toolhead != MODULE_TOOLHEAD_3DP && toolhead != MODULE_TOOLHEAD_DUALEXTRUDER)
+    return;
+
+  if (!MeshValid())
+    return;
+
+  const float base = z_values[0][0];
+  bool same = false;
+  uint8_t i = Find(toolhead, bed_);
+
+  if (i != MESH_SLOT_NONE) {
+    // most saves don't touch the mesh, keep its stamp
+    same = slot[i].grid_x == GRID_MAX_POINTS_X && slot[i].grid_y == GRID_MAX_POINTS_Y && slot[i].base == base;
+    for (uint8_t x = 0; same && x < GRID_MAX_POINTS_X; x++)
+      for (uint8_t y = 0; same && y < GRID_MAX_POINTS_Y; y++)
+        same = slot[i].z[x][y] == (int16_t)LROUND((z_values[x][y] - base) * 1000);
+  }
+
+  if (same) {
+    active_ = i;
+    return;
+  }
+
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      if (!WITHIN(z_values[x][y] - base, -32.767f, 32.767f)) {
+        LOG_E("mesh slot: point[%u][%u] %.3f out of range\n", x, y, z_values[x][y]);
+        return;
+      }
+
+  uint32_t seq = 0;
+  for (uint8_t j = 0; j < MESH_SLOT_NUM; j++)
+    if (slot[j].toolhead != MODULE_TOOLHEAD_UNKNOW)
+      NOLESS(seq, slot[j].seq);
+
+  // take a free slot, or the one stored longest ago
+  if (i == MESH_SLOT_NONE) {
+    for (uint8_t j = 0; j < MESH_SLOT_NUM; j++) {
+      if (slot[j].toolhead == MODULE_TOOLHEAD_UNKNOW) {
+        i = j;
+        break;
+      }
+      if (i == MESH_SLOT_NONE || slot[j].seq < slot[i].seq)
+        i = j;
+    }
+  }
+
+  mesh_slot_t &m = slot[i];
+  m.toolhead = toolhead;
+  m.bed = bed_;
+  m.grid_x = GRID_MAX_POINTS_X;
+  m.grid_y = GRID_MAX_POINTS_Y;
+  m.bed_temp = LROUND(thermalManager.degBed());
+  m.seq = seq + 1;
+  m.timestamp = time();
+  m.base = base;
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      m.z[x][y] = (int16_t)LROUND((z_values[x][y] - base) * 1000);
+
+  active_ = i;
+
+  LOG_I("mesh slot %u: stored, toolhead: %u, bed: %u, grid: %u\n", i, m.toolhead, m.bed, m.grid_x);
+}
+
+
+bool MeshSlot::Load(uint8_t i) {
+  if (i >= MESH_SLOT_NUM || slot[i].toolhead == MODULE_TOOLHEAD_UNKNOW)
+    return false;
+
+  const mesh_slot_t &m = slot[i];
+  const bool leveling = planner.leveling_active;
+
+  set_bed_leveling_enabled(false);
+
+  GRID_MAX_POINTS_X = m.grid_x;
+  GRID_MAX_POINTS_Y = m.grid_y;
+  ABL_GRID_POINTS_VIRT_X = (GRID_MAX_POINTS_X - 1) * (BILINEAR_SUBDIVISIONS) + 1;
+  ABL_GRID_POINTS_VIRT_Y = (GRID_MAX_POINTS_Y - 1) * (BILINEAR_SUBDIVISIONS) + 1;
+  ABL_TEMP_POINTS_X = (GRID_MAX_POINTS_X + 2);
+  ABL_TEMP_POINTS_Y = (GRID_MAX_POINTS_Y + 2);
+
+  bilinear_grid_manual();
+
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      z_values[x][y] = m.base + m.z[x][y] * 0.001f;
+
+  bed_level_virt_interpolate();
+
+  set_bed_leveling_enabled(leveling);
+
+  active_ = i;
+
+  TERN_(BED_THERMAL_DRIFT, thermal_drift.SetMeshTemp(m.bed_temp));
+
+  LOG_I("mesh slot %u: loaded, toolhead: %u, bed: %u, bed temp: %d\n", i, m.toolhead, m.bed, m.bed_temp);
+  return true;
+}
+
+
+bool MeshSlot::Select(uint8_t toolhead, uint8_t bed) {
+  bed_ = bed;
+
+  // other toolheads don't level, drop the mesh as before, it is still in its slot
+  if (toolhead != MODULE_TOOLHEAD_3DP && toolhead != MODULE_TOOLHEAD_DUALEXTRUDER) {
+    active_ = MESH_SLOT_NONE;
+    if (!MeshValid())
+      return false;
+
+    for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+      for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+        z_values[x][y] = DEFAUT_LEVELING_HEIGHT_3DP2E;
+    bed_level_virt_interpolate();
+    return true;
+  }
+
+  const uint8_t i = Find(toolhead, bed);
+
+  if (i != MESH_SLOT_NONE) {
+    if (i == active_ && MeshValid())
+      return false;
+    return Load(i);
+  }
+
+  // no mesh for this setup, don't keep the one of another setup
+  if (active_ != MESH_SLOT_NONE) {
+    active_ = MESH_SLOT_NONE;
+    reset_bed_level();
+    bed_level_virt_interpolate();
+    return true;
+  }
+
+  // mesh which was never stored, e.g. from before the slots, keep it
+  return false;
+}
+
+#endif // ENABLED(LEVELING_MESH_SLOTS)
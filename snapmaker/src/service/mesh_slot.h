@@ -0,0 +1,88 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SNAPMAKER_MESH_SLOT_H_
+#define SNAPMAKER_MESH_SLOT_H_
+
+#include "../common/config.h"
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(LEVELING_MESH_SLOTS)
+
+#define MESH_SLOT_NONE  0xFF
+
+// one leveling mesh with the setup it was probed on
+typedef struct {
+  uint8_t  toolhead;    // ModuleToolHeadType, MODULE_TOOLHEAD_UNKNOW if the slot is free
+  uint8_t  bed;         // bed id, set by M1035 B
+  uint8_t  grid_x;      // GRID_MAX_POINTS_X
+  uint8_t  grid_y;      // GRID_MAX_POINTS_Y
+  int16_t  bed_temp;    // (°C) bed when stored
+  uint16_t reserved;
+  uint32_t seq;         // increased on each store, the least is replaced first
+  uint32_t timestamp;   // (s) host time when stored, 0 if host never gave the time
+  float    base;        // (mm) heights are relative to it
+  int16_t  z[GRID_MAX_NUM][GRID_MAX_NUM];  // (um)
+} mesh_slot_t;
+
+class MeshSlot {
+  public:
+    void Reset();
+
+    // called before saving settings, keep the mesh in use in the slot of current setup
+    void Capture();
+
+    // called when toolhead is detected or bed is changed, load the mesh of the setup
+    // return true if z_values was changed
+    bool Select(uint8_t toolhead, uint8_t bed);
+
+    bool Load(uint8_t i);
+    void Clear(uint8_t i);
+
+    // host time in seconds, to stamp the meshes
+    void SetTime(uint32_t seconds);
+    uint32_t time();
+
+    // false if z_values only has the default heights
+    static bool MeshValid();
+
+    uint8_t bed() { return bed_; }
+    uint8_t active() { return active_; }
+
+  public:
+    // saved by M500
+    mesh_slot_t slot[MESH_SLOT_NUM];
+    uint8_t bed_ = 0;
+    uint8_t active_ = MESH_SLOT_NONE;
+
+  private:
+    uint8_t Find(uint8_t toolhead, uint8_t bed);
+
+  private:
+    uint32_t time_base_ = 0;
+    millis_t time_base_ms_ = 0;
+};
+
+extern MeshSlot mesh_slot;
+
+#endif // ENABLED(LEVELING_MESH_SLOTS)
+
+#endif // #ifndef SNAPMAKER_MESH_SLOT_H_
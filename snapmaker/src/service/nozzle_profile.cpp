@@ -0,0 +1,130 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "nozzle_profile.h"
+
+#if ENABLED(NOZZLE_MOTION_PROFILE)
+
+#include "../common/debug.h"
+
+#include "src/module/planner.h"
+#include "src/module/stepper.h"
+#include "src/module/ft_motion.h"
+
+NozzleProfile nozzle_profile;
+
+
+void NozzleProfile::Reset() {
+  for (uint8_t i = 0; i < HOTEND_INFO_MAX; i++) {
+    profile[i].acceleration = 0;
+    profile[i].travel_acceleration = 0;
+    profile[i].retract_acceleration = 0;
+    profile[i].shaping_freq[0] = 0;
+    profile[i].shaping_freq[1] = 0;
+    profile[i].advance_K = -1;
+    profile[i].max_flow = 0;
+  }
+}
+
+
+void NozzleProfile::Detected(uint8_t e, uint8_t type) {
+  if (e >= EXTRUDERS)
+    return;
+
+  type_[e] = type < HOTEND_INFO_MAX ? type : NOZZLE_PROFILE_NONE;
+  pending_ = true;
+}
+
+
+void NozzleProfile::Process() {
+  // only when standing still, don't change shaping under a running move
+  if (!pending_ || planner.has_blocks_queued())
+    return;
+
+  Apply();
+}
+
+
+void NozzleProfile::Apply() {
+  pending_ = false;
+
+  // K and flow are kept by planner for each extruder
+  for (uint8_t e = 0; e < EXTRUDERS; e++) {
+    if (type_[e] == NOZZLE_PROFILE_NONE)
+      continue;
+
+    const nozzle_profile_t &p = profile[type_[e]];
+
+    #if ENABLED(LIN_ADVANCE)
+      if (p.advance_K >= 0) {
+        planner.extruder_advance_K[e] = p.advance_K;
+        LOG_I("nozzle profile %u for E%u: K %.3f\n", type_[e], e, p.advance_K);
+      }
+    #endif
+
+    #if ENABLED(VOLUMETRIC_FLOW_LIMIT)
+      if (p.max_flow > 0)
+        planner.set_volumetric_extruder_limit(e, p.max_flow);
+    #endif
+  }
+
+  const uint8_t type = type_[active_extruder];
+  if (type == NOZZLE_PROFILE_NONE)
+    return;
+
+  const nozzle_profile_t &p = profile[type];
+
+  // others are global, take the ones of active nozzle, for the following moves
+  planner.settings.acceleration = p.acceleration > 0 ? p.acceleration : planner.settings.fdm.acceleration;
+  planner.settings.travel_acceleration = p.travel_acceleration > 0 ? p.travel_acceleration : planner.settings.fdm.travel_acceleration;
+  planner.settings.retract_acceleration = p.retract_acceleration > 0 ? p.retract_acceleration : planner.settings.fdm.retract_acceleration;
+
+  #if ENABLED(FT_MOTION) && HAS_X_AXIS
+    bool update_n = false;
+    if (p.shaping_freq[0] > 0 && p.shaping_freq[0] != ftMotion.cfg.baseFreq[X_AXIS]) {
+      ftMotion.cfg.baseFreq[X_AXIS] = p.shaping_freq[0];
+      update_n = true;
+    }
+    #if HAS_Y_AXIS
+      if (p.shaping_freq[1] > 0 && p.shaping_freq[1] != ftMotion.cfg.baseFreq[Y_AXIS]) {
+        ftMotion.cfg.baseFreq[Y_AXIS] = p.shaping_freq[1];
+        update_n = true;
+      }
+    #endif
+
+    if (update_n) {
+      // as M493 does, shaper must not change under the moves already planned
+      planner.synchronize();
+      ftMotion.refreshShapingN();
+      if (ftMotion.cfg.mode) {
+        stepper.reinit_for_ftmotion();
+        stepper.ftMotion_syncPosition();
+        ftMotion.reset();
+      }
+      LOG_I("nozzle profile %u: shaping %.1f/%.1f Hz\n", type, ftMotion.cfg.baseFreq[X_AXIS], ftMotion.cfg.baseFreq[Y_AXIS]);
+    }
+  #endif
+
+  LOG_I("nozzle profile %u (%.1f mm) for E%u: accel %.0f, travel %.0f, retract %.0f\n",
+        type, hotend_info[type].diameter, active_extruder, planner.settings.acceleration,
+        planner.settings.travel_acceleration, planner.settings.retract_acceleration);
+}
+
+#endif // ENABLED(NOZZLE_MOTION_PROFILE)
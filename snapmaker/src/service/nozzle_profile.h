@@ -0,0 +1,76 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SNAPMAKER_NOZZLE_PROFILE_H_
+#define SNAPMAKER_NOZZLE_PROFILE_H_
+
+#include "../common/config.h"
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(NOZZLE_MOTION_PROFILE)
+
+#include "../module/toolhead_dualextruder.h"
+
+#define NOZZLE_PROFILE_NONE  0xFF
+
+// tuned motion for one nozzle type, index is the same as hotend_info
+typedef struct {
+  float acceleration;           // (mm/s^2) M204 P, 0 to keep
+  float travel_acceleration;    // (mm/s^2) M204 T, 0 to keep
+  float retract_acceleration;   // (mm/s^2) M204 R, 0 to keep
+  float shaping_freq[2];        // (Hz) M493 A B, 0 to keep
+  float advance_K;              // M900 K, -1 to keep
+  float max_flow;               // (mm³/s) M1033 S, 0 to keep
+} nozzle_profile_t;
+
+class NozzleProfile {
+  public:
+    NozzleProfile() {
+      for (uint8_t e = 0; e < EXTRUDERS; e++)
+        type_[e] = NOZZLE_PROFILE_NONE;
+    }
+
+    void Reset();
+
+    // called by CAN task when module reports the nozzle types, hotend_info index of each extruder
+    void Detected(uint8_t e, uint8_t type);
+
+    // called in idle() of Marlin task, apply the profiles after a new detection
+    void Process();
+
+    // called in Marlin task, also by tool change
+    void Apply();
+
+    uint8_t type(uint8_t e) { return e < EXTRUDERS ? type_[e] : NOZZLE_PROFILE_NONE; }
+
+  public:
+    nozzle_profile_t profile[HOTEND_INFO_MAX];  // saved by M500
+
+  private:
+    uint8_t type_[EXTRUDERS];
+    volatile bool pending_ = false;
+};
+
+extern NozzleProfile nozzle_profile;
+
+#endif // ENABLED(NOZZLE_MOTION_PROFILE)
+
+#endif // #ifndef SNAPMAKER_NOZZLE_PROFILE_H_
@@ -37,12 +37,14 @@
 #include "src/Marlin.h"
 #include "src/gcode/gcode.h"
 #include "src/gcode/parser.h"
+#include "src/gcode/queue.h"
 #include "src/module/configuration_store.h"
 #include "src/module/printcounter.h"
 #include "src/module/stepper.h"
 #include "src/module/temperature.h"
 #include "src/module/planner.h"
 #include "src/module/motion.h"
+#include "src/module/ft_motion.h"
 #include "src/feature/runout.h"
 #include "src/feature/bedlevel/bedlevel.h"
 
@@ -231,6 +233,12 @@ int PowerLossRecovery::Load(void)
 				pre_data_.Valid = 0;
 				ret = 1;
 			}
+			else if (pre_data_.Version != PL_DATA_VERSION) {
+				// written by a firmware with other layout, the fields can't be trusted
+				LOG_E("PL: data version %u, should be %u\n", pre_data_.Version, PL_DATA_VERSION);
+				pre_data_.Valid = 0;
+				ret = 1;
+			}
 			else {
 				// correct checksum
 				pre_data_.Valid = 1;
@@ -274,6 +282,7 @@ void PowerLossRecovery::WriteFlash(void)
 	uint8_t *pBuff;
 
   pBuff = (uint8_t *)&cur_data_;
+	cur_data_.Version = PL_DATA_VERSION;
 	cur_data_.CheckSum = 0;
 	for(uint32_t i = 0; i < (int)sizeof(PowerLossRecoveryData_t); i++)
 		cur_data_.CheckSum += pBuff[i];
@@ -423,6 +432,10 @@ int PowerLossRecovery::SaveEnv(void) {
 			  && systemservice.GetBackupCurrentPosition(backup_position, sizeof(backup_position))) {
 			LOOP_X_TO_EN(i) cur_data_.PositionData[i] = backup_position[i];
 			cur_data_.too_changing = true;
+		#if ENABLED(RESUME_LINE_REMAINDER)
+			// stopped away from the line, run it again
+			cur_data_.line_remain_valid = false;
+		#endif
 		}
     break;
 
@@ -461,6 +474,108 @@ int PowerLossRecovery::SaveEnv(void) {
   return 0;
 }
 
+#if ENABLED(RESUME_LINE_REMAINDER)
+
+// add the last 'left' of 'total' step events of a block, Bresenham keeps the axes in proportion
+static void add_block_steps(int32_t (&steps)[NUM_AXIS], const block_t *blk, uint32_t left, uint32_t total) {
+  const float ratio = (float)left / total;
+  LOOP_X_TO_E(i) {
+    const int32_t s = (left == total) ? blk->steps[i] : LROUND(blk->steps[i] * ratio);
+    steps[i] += TEST(blk->direction_bits, i) ? -s : s;
+  }
+}
+
+void PowerLossRecovery::SaveLineRemainder(block_t *blk) {
+  uint32_t line = last_line_;
+
+  cur_data_.line_remain_valid = false;
+  LOOP_X_TO_E(i) cur_data_.line_remain_steps[i] = 0;
+  cur_data_.line_remain_speed = 0;
+
+  // FT motion has taken the blocks ahead of the steppers
+  if (ftMotion.cfg.mode)
+    return;
+
+  if (blk) {
+    if (blk->filePos == INVALID_CMD_LINE || TEST(blk->flag, BLOCK_BIT_SYNC_POSITION))
+      goto resend;
+
+    line = blk->filePos;
+    cur_data_.line_remain_speed = blk->nominal_speed;
+    add_block_steps(cur_data_.line_remain_steps, blk, blk->step_event_count - stepper.block_steps_completed(), blk->step_event_count);
+
+    // the other blocks of the line, e.g. segments of leveling
+    for (uint8_t b = BLOCK_MOD(planner.block_buffer_tail + 1); b != planner.block_buffer_head; b = BLOCK_MOD(b + 1)) {
+      const block_t *next = &planner.block_buffer[b];
+      if (next->filePos != line)
+        break;
+      // a position sync in the middle cannot be replayed as a move
+      if (TEST(next->flag, BLOCK_BIT_SYNC_POSITION))
+        goto resend;
+      add_block_steps(cur_data_.line_remain_steps, next, next->step_event_count, next->step_event_count);
+    }
+  }
+
+  // the line is still being planned, the rest of it is unknown
+  if (line == INVALID_CMD_LINE || (commands_in_queue && CommandLine[cmd_queue_index_r] == line))
+    goto resend;
+
+  cur_data_.line_remain_valid = true;
+  return;
+
+resend:
+#if ENABLED(MOVE_COALESCING)
+  // the block carries the last line of a coalesced run, resending from it would
+  // skip the commands before it, so the whole run goes again
+  if (blk)
+    SaveCmdLine(blk->filePosFirst);
+#endif
+  return;
+}
+
+
+void PowerLossRecovery::ResumeLineRemainder(void) {
+  float target[X_TO_E];
+  bool has_move = false;
+
+  if (!cur_data_.line_remain_valid)
+    return;
+
+  // remaining steps are native, leveling has been applied when they were planned
+  LOOP_X_TO_E(i) {
+    const uint8_t axis = (i == E_AXIS) ? E_AXIS_N(active_extruder) : i;
+    target[i] = (planner.position[i] + cur_data_.line_remain_steps[i]) * planner.steps_to_mm[axis];
+    if (cur_data_.line_remain_steps[i])
+      has_move = true;
+  }
+
+  if (has_move) {
+    LOG_I("resume rest of line %u at %.1f mm/s\n", cur_data_.FilePosition, cur_data_.line_remain_speed);
+    planner.buffer_segment(target, MAX(cur_data_.line_remain_speed, 1.0f), active_extruder);
+    planner.synchronize();
+    set_current_from_steppers_for_axis(ALL_AXES);
+  }
+
+  cur_data_.line_remain_valid = false;
+}
+
+#endif // ENABLED(RESUME_LINE_REMAINDER)
+
+
+uint32_t PowerLossRecovery::ResumeStartLine(void) {
+  if (cur_data_.FilePosition <= 0)
+    return 0;
+
+#if ENABLED(RESUME_LINE_REMAINDER)
+  // the line will be finished by ResumeLineRemainder()
+  if (cur_data_.line_remain_valid)
+    return cur_data_.FilePosition;
+#endif
+
+  return cur_data_.FilePosition - 1;
+}
+
+
 void PowerLossRecovery::Resume3DP() {
 	HOTEND_LOOP() {
     // restore feedrate_percentage
@@ -669,6 +784,13 @@ ErrCode PowerLossRecovery::ResumeWork() {
 		return E_INVALID_STATE;
 	}
 
+#if ENABLED(RESUME_LINE_REMAINDER)
+	// ResumeOver() and ResumeStartLine() work on cur_data_
+	cur_data_.line_remain_valid = pre_data_.line_remain_valid;
+	LOOP_X_TO_E(i) cur_data_.line_remain_steps[i] = pre_data_.line_remain_steps[i];
+	cur_data_.line_remain_speed = pre_data_.line_remain_speed;
+#endif
+
 	LOG_I("restore point: X:%.2f, Y: %.2f, Z: %.2f, B: %.2f, E: %.2f)\n", pre_data_.PositionData[X_AXIS], pre_data_.PositionData[Y_AXIS],
 			pre_data_.PositionData[Z_AXIS], pre_data_.PositionData[B_AXIS], pre_data_.PositionData[E_AXIS]);
 
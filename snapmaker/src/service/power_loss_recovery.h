@@ -38,9 +38,16 @@ typedef enum {
 
 // delay for debounce, uint: ms, for now we use 10ms
 #define POWERPANIC_DEBOUNCE	10
+// layout of PowerLossRecoveryData_t, bump it when a field is added, removed
+// or changed, records of another layout are dropped instead of misread
+//   2: version field, rest of the interrupted line (RESUME_LINE_REMAINDER)
+#define PL_DATA_VERSION  2
+
 typedef struct __attribute__((aligned (4))) {
 	// checksum of this section
 	uint32_t CheckSum;
+	// PL_DATA_VERSION of the firmware which wrote it
+	uint32_t Version;
 	// temperature of extrucders
 	int16_t HeaterTemp[PP_HEATER];
 	// speed of work
@@ -92,6 +99,13 @@ typedef struct __attribute__((aligned (4))) {
 	bool half_power_mode;
 	bool weak_light_origin_mode;
 	block_inline_laser_t laser_info;
+
+	// always in the layout, so it doesn't change with RESUME_LINE_REMAINDER
+	// steps from the stop point to the end of the line FilePosition,
+	// if valid, resume runs them and goes on from the next line
+	bool line_remain_valid;
+	int32_t line_remain_steps[NUM_AXIS];
+	float line_remain_speed;
 } PowerLossRecoveryData_t;
 
 
@@ -123,6 +137,18 @@ class PowerLossRecovery {
 	void Reset(void);
 	void Check(void);
 
+#if ENABLED(RESUME_LINE_REMAINDER)
+    /*
+    * record the rest of the line of the interrupted block,
+    * called by stepper isr() when quick stop is triggered
+    */
+    void SaveLineRemainder(block_t *blk);
+    // run the rest of the line, called by Marlin task in resuming
+    void ResumeLineRemainder(void);
+#endif
+    // host sends the lines after this one when resuming
+    uint32_t ResumeStartLine(void);
+
       uint32_t LastLine() { return last_line_; }
 
 	public:
@@ -22,6 +22,7 @@
 
 #include "power_loss_recovery.h"
 #include "system.h"
+#include "laser_raster.h"
 
 #include "../module/toolhead_cnc.h"
 #include "../module/toolhead_3dp.h"
@@ -33,6 +34,7 @@
 #include "src/module/temperature.h"
 #include "src/module/printcounter.h"
 #include "src/feature/bedlevel/bedlevel.h"
+#include "src/module/move_coalescer.h"
 #include <src/gcode/gcode.h>
 #include HAL_PATH(src/HAL, HAL_watchdog_STM32F1.h)
 
@@ -149,8 +151,12 @@ bool QuickStopService::CheckInISR(block_t *blk) {
         }
 
         // if power-loss appear atfer finishing PAUSE, won't save env again
-        if (systemservice.GetCurrentStatus() != SYSTAT_PAUSE_FINISH)
+        if (systemservice.GetCurrentStatus() != SYSTAT_PAUSE_FINISH) {
+          #if ENABLED(RESUME_LINE_REMAINDER)
+            pl_recovery.SaveLineRemainder(blk);
+          #endif
           pl_recovery.SaveEnv();
+        }
       }
 
       // write flash only power-loss appear
@@ -432,6 +438,16 @@ void QuickStopService::Process() {
   set_current_from_steppers_for_axis(ALL_AXES);
   sync_plan_position();
 
+  #if ENABLED(MOVE_COALESCING)
+    // a held coalesced move is stale now that position comes from the steppers
+    coalescer.discard();
+  #endif
+
+  #if ENABLED(LASER_RASTER_MODE)
+    // scanlines of the cleaned blocks will never be burned
+    laser_raster.Reset();
+  #endif
+
   // switch to QS_STA_PARKING, to recover stepper output
   state_ = QS_STA_PARKING;
 
@@ -570,6 +570,11 @@ ErrCode SystemService::ResumeOver() {
     break;
   }
 
+#if ENABLED(RESUME_LINE_REMAINDER)
+  // finish the interrupted line, host goes on from the next one
+  pl_recovery.ResumeLineRemainder();
+#endif
+
   LOG_I("got 1rst cmd after resume\n");
   cur_status_ = SYSTAT_WORK;
   //lightbar.set_state(LB_STATE_WORKING);
@@ -1959,12 +1964,7 @@ ErrCode SystemService::ChangeSystemStatus(SSTP_Event_t &event) {
       need_pre_extrusion = true;
       if (err == E_SUCCESS) {
         pl_recovery.SaveCmdLine(pl_recovery.cur_data_.FilePosition);
-        if (pl_recovery.cur_data_.FilePosition > 0) {
-          current_line_ =  pl_recovery.cur_data_.FilePosition - 1;
-        }
-        else {
-          current_line_ = 0;
-        }
+        current_line_ = pl_recovery.ResumeStartLine();
         gocde_pack_start_line(current_line_);
         SNAP_DEBUG_SET_GCODE_LINE(current_line_);
         LOG_I("RESUME over\n");
@@ -2112,10 +2112,7 @@ ErrCode SystemService::RecoverFromPowerLoss(SSTP_Event_t &event) {
       //         planner.laser_inline.power, planner.laser_inline.sync_power);
       // }
       pl_recovery.cur_data_.FilePosition = pl_recovery.pre_data_.FilePosition;
-      if (pl_recovery.cur_data_.FilePosition > 0)
-        current_line_ =  pl_recovery.cur_data_.FilePosition - 1;
-      else
-        current_line_ = 0;
+      current_line_ = pl_recovery.ResumeStartLine();
       // Batch sending requires the controller to actively request the next line
       gocde_pack_start_line(current_line_);
       SNAP_DEBUG_SET_GCODE_LINE(current_line_);
@@ -0,0 +1,170 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "temp_telemetry.h"
+
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+
+#include "../common/debug.h"
+#include "../hmi/event_handler.h"
+#include "../module/module_base.h"
+
+#include "src/Marlin.h"
+#include "src/module/temperature.h"
+
+TempTelemetry temp_telemetry;
+
+
+uint8_t TempTelemetry::hotends() {
+  switch (ModuleBase::toolhead()) {
+  case MODULE_TOOLHEAD_3DP:
+    return 1;
+
+  case MODULE_TOOLHEAD_DUALEXTRUDER:
+    return 2;
+
+  default:
+    return 0;
+  }
+}
+
+
+uint16_t TempTelemetry::SampleInterval(uint8_t e) {
+  TempSample_t samples[HOTEND_TEMP_HISTORY_SIZE];
+  uint8_t count = printer1->GetTempHistory(samples, HOTEND_TEMP_HISTORY_SIZE, e);
+
+  if (count < 2)
+    return 0;
+
+  return (samples[0].ms - samples[count - 1].ms) / (count - 1);
+}
+
+
+int16_t TempTelemetry::SampleRate(uint8_t e) {
+  TempSample_t samples[HOTEND_TEMP_HISTORY_SIZE];
+  uint8_t count = printer1->GetTempHistory(samples, HOTEND_TEMP_HISTORY_SIZE, e);
+
+  if (count < 2 || samples[0].ms == samples[count - 1].ms)
+    return 0;
+
+  return (int32_t)(samples[0].temp - samples[count - 1].temp) * 1000 / (int32_t)(samples[0].ms - samples[count - 1].ms);
+}
+
+
+void TempTelemetry::serial_interval(uint16_t ms) {
+  if (ms && ms < TEMP_TELEMETRY_MIN_INTERVAL)
+    ms = TEMP_TELEMETRY_MIN_INTERVAL;
+
+  serial_interval_ = ms;
+  serial_next_ = millis();
+}
+
+
+/**
+ * One line for all hotends, with every sample received since last line:
+ *   TS T0 S<target> <ms>:<temp> <ms>:<temp> ... T1 S<target> ...
+ */
+void TempTelemetry::Process() {
+  TempSample_t samples[HOTEND_TEMP_HISTORY_SIZE];
+  uint32_t newest;
+
+  if (!serial_interval_ || PENDING(millis(), serial_next_))
+    return;
+
+  serial_next_ = millis() + serial_interval_;
+
+  uint8_t n = hotends();
+  if (!n)
+    return;
+
+  PORT_REDIRECT(SERIAL_BOTH);
+  SERIAL_ECHOPGM("TS");
+
+  for (uint8_t e = 0; e < n; e++) {
+    uint8_t count = printer1->GetTempHistory(samples, HOTEND_TEMP_HISTORY_SIZE, e, &newest);
+    if (newest - serial_seq_[e] < count)
+      count = newest - serial_seq_[e];
+    serial_seq_[e] = newest;
+
+    SERIAL_ECHOPAIR(" T", e, " S", thermalManager.degTargetHotend(e));
+    while (count--)
+      SERIAL_ECHOPAIR(" ", samples[count].ms, ":", samples[count].temp / 10.0f);
+  }
+
+  SERIAL_EOL();
+}
+
+
+void TempTelemetry::CheckIfSendReport() {
+  SSTP_Event_t event = {EID_SYS_CTRL_ACK, SYSCTL_OPC_TEMP_REPORT};
+  uint8_t buff[1 + EXTRUDERS * 8];
+  int16_t tmp_i16;
+  int i = 0;
+
+  if (!hmi_interval_ || PENDING(millis(), hmi_next_))
+    return;
+
+  hmi_next_ = millis() + hmi_interval_;
+
+  uint8_t n = hotends();
+  if (!n)
+    return;
+
+  buff[i++] = n;
+  for (uint8_t e = 0; e < n; e++) {
+    tmp_i16 = printer1->GetTemp(e);
+    HWORD_TO_PDU_BYTES_INDE_MOVE(buff, tmp_i16, i);
+    tmp_i16 = thermalManager.degTargetHotend(e);
+    HWORD_TO_PDU_BYTES_INDE_MOVE(buff, tmp_i16, i);
+    tmp_i16 = (int16_t)_MIN(printer1->GetTempAge(e), (millis_t)INT16_MAX);
+    HWORD_TO_PDU_BYTES_INDE_MOVE(buff, tmp_i16, i);
+    tmp_i16 = SampleRate(e);
+    HWORD_TO_PDU_BYTES_INDE_MOVE(buff, tmp_i16, i);
+  }
+
+  event.data   = buff;
+  event.length = (uint16_t)i;
+  hmi.Send(event);
+}
+
+
+ErrCode TempTelemetry::HmiSetReport(SSTP_Event_t &event) {
+  ErrCode err = E_SUCCESS;
+  uint16_t ms;
+
+  if (event.length < 2) {
+    LOG_E("temp report: need interval\n");
+    err = E_PARAM;
+  }
+  else {
+    PDU_TO_LOCAL_HALF_WORD(ms, event.data);
+    if (ms && ms < TEMP_TELEMETRY_MIN_INTERVAL)
+      ms = TEMP_TELEMETRY_MIN_INTERVAL;
+    hmi_interval_ = ms;
+    hmi_next_ = millis();
+    LOG_I("temp report to HMI every %u ms\n", ms);
+  }
+
+  event.data   = &err;
+  event.length = 1;
+  return hmi.Send(event);
+}
+
+#endif // ENABLED(HOTEND_TEMP_TELEMETRY)
@@ -0,0 +1,71 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SNAPMAKER_TEMP_TELEMETRY_H_
+#define SNAPMAKER_TEMP_TELEMETRY_H_
+
+#include "../common/config.h"
+#include "../common/error.h"
+#include "../common/protocol_sstp.h"
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(HOTEND_TEMP_TELEMETRY)
+
+#include "../module/toolhead_3dp.h"
+
+#define TEMP_TELEMETRY_MIN_INTERVAL  50  // (ms)
+
+// streams the samples kept by printer1, never polls the module itself
+class TempTelemetry {
+  public:
+    // called in idle() of Marlin task, print new samples to serial ports
+    void Process();
+
+    // called by HMI task, send the latest sample of each hotend to HMI
+    void CheckIfSendReport();
+
+    // callback for HMI event, payload: interval in ms (2), 0 to stop
+    ErrCode HmiSetReport(SSTP_Event_t &event);
+
+    void serial_interval(uint16_t ms);
+    uint16_t serial_interval() { return serial_interval_; }
+
+    // number of hotends to report for current toolhead, 0 if not a printing toolhead
+    uint8_t hotends();
+    // mean interval in ms of the samples in history, 0 if not enough samples
+    uint16_t SampleInterval(uint8_t e);
+    // slope in 0.1 degree per second over the samples in history
+    int16_t SampleRate(uint8_t e);
+
+  private:
+    uint16_t serial_interval_ = 0;
+    uint16_t hmi_interval_ = 0;
+    millis_t serial_next_ = 0;
+    millis_t hmi_next_ = 0;
+
+    uint32_t serial_seq_[EXTRUDERS] = { 0 };  // samples already printed
+};
+
+extern TempTelemetry temp_telemetry;
+
+#endif // ENABLED(HOTEND_TEMP_TELEMETRY)
+
+#endif // #ifndef SNAPMAKER_TEMP_TELEMETRY_H_
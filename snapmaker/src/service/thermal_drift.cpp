@@ -0,0 +1,246 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "thermal_drift.h"
+
+#if ENABLED(BED_THERMAL_DRIFT)
+
+#include "../common/debug.h"
+
+#include "src/module/temperature.h"
+#include "src/feature/bedlevel/bedlevel.h"
+
+ThermalDrift thermal_drift;
+
+// samples closer than this are taken as the same temperature
+#define THERMAL_DRIFT_SAME_TEMP  2.0f
+// need this span to fit a slope
+#define THERMAL_DRIFT_MIN_SPAN   5.0f
+// don't move the mesh for less temperature change
+#define THERMAL_DRIFT_STEP       0.5f
+
+
+void ThermalDrift::Reset() {
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.enabled = true;
+  cfg.mesh_temp = NAN;
+  fitted_ = false;
+  Unapply();
+}
+
+
+void ThermalDrift::Point(uint8_t k, float &x, float &y) {
+  const float x0 = _GET_MESH_X(0), x1 = _GET_MESH_X(GRID_MAX_POINTS_X - 1),
+              y0 = _GET_MESH_Y(0), y1 = _GET_MESH_Y(GRID_MAX_POINTS_Y - 1);
+
+  switch (k) {
+    case 0:  x = x0; y = y0; break;
+    case 1:  x = x1; y = y0; break;
+    case 2:  x = x0; y = y1; break;
+    case 3:  x = x1; y = y1; break;
+    default: x = (x0 + x1) / 2; y = (y0 + y1) / 2; break;
+  }
+}
+
+
+void ThermalDrift::AddSample(float temp, const float (&x)[THERMAL_DRIFT_POINTS],
+                             const float (&y)[THERMAL_DRIFT_POINTS], const float (&z)[THERMAL_DRIFT_POINTS]) {
+  uint8_t i;
+
+  // the points moved with the grid, old samples don't fit them
+  for (i = 0; i < THERMAL_DRIFT_POINTS; i++) {
+    if (cfg.samples && (ABS(cfg.x[i] - x[i]) > 1 || ABS(cfg.y[i] - y[i]) > 1)) {
+      LOG_I("thermal drift: points moved, drop %u samples\n", cfg.samples);
+      cfg.samples = 0;
+    }
+    cfg.x[i] = x[i];
+    cfg.y[i] = y[i];
+  }
+
+  // replace the sample at the same temperature, or the closest one if full
+  uint8_t closest = 0;
+  for (i = 0; i < cfg.samples; i++) {
+    if (ABS(cfg.temp[i] - temp) < ABS(cfg.temp[closest] - temp))
+      closest = i;
+  }
+
+  if (cfg.samples && ABS(cfg.temp[closest] - temp) < THERMAL_DRIFT_SAME_TEMP)
+    i = closest;
+  else if (cfg.samples < THERMAL_DRIFT_TEMPS)
+    i = cfg.samples++;
+  else
+    i = closest;
+
+  cfg.temp[i] = temp;
+  for (uint8_t k = 0; k < THERMAL_DRIFT_POINTS; k++)
+    cfg.z[i][k] = z[k];
+
+  LOG_I("thermal drift: sample %u at %.1f, %u in all\n", i, temp, cfg.samples);
+
+  Fit();
+}
+
+
+bool ThermalDrift::Fit() {
+  float tmin = 999, tmax = -999, tm = 0;
+
+  fitted_ = false;
+
+  if (cfg.samples < 2)
+    return false;
+
+  for (uint8_t i = 0; i < cfg.samples; i++) {
+    NOMORE(tmin, cfg.temp[i]);
+    NOLESS(tmax, cfg.temp[i]);
+    tm += cfg.temp[i];
+  }
+  tm /= cfg.samples;
+
+  if (tmax - tmin < THERMAL_DRIFT_MIN_SPAN)
+    return false;
+
+  // least squares dz/dT of each point
+  float slope[THERMAL_DRIFT_POINTS];
+  float stt = 0;
+  for (uint8_t i = 0; i < cfg.samples; i++)
+    stt += sq(cfg.temp[i] - tm);
+
+  for (uint8_t k = 0; k < THERMAL_DRIFT_POINTS; k++) {
+    float zm = 0, stz = 0;
+    for (uint8_t i = 0; i < cfg.samples; i++)
+      zm += cfg.z[i][k];
+    zm /= cfg.samples;
+    for (uint8_t i = 0; i < cfg.samples; i++)
+      stz += (cfg.temp[i] - tm) * (cfg.z[i][k] - zm);
+    slope[k] = stz / stt;
+  }
+
+  // plane of the slopes, the points are symmetric so X and Y fit apart
+  center_[0] = center_[1] = 0;
+  for (uint8_t k = 0; k < THERMAL_DRIFT_POINTS; k++) {
+    center_[0] += cfg.x[k];
+    center_[1] += cfg.y[k];
+  }
+  center_[0] /= THERMAL_DRIFT_POINTS;
+  center_[1] /= THERMAL_DRIFT_POINTS;
+
+  float s = 0, sx = 0, sy = 0, sxx = 0, syy = 0;
+  for (uint8_t k = 0; k < THERMAL_DRIFT_POINTS; k++) {
+    const float dx = cfg.x[k] - center_[0], dy = cfg.y[k] - center_[1];
+    s += slope[k];
+    sx += dx * slope[k];
+    sy += dy * slope[k];
+    sxx += sq(dx);
+    syy += sq(dy);
+  }
+
+  coef_[0] = s / THERMAL_DRIFT_POINTS;
+  coef_[1] = sxx > 0 ? sx / sxx : 0;
+  coef_[2] = syy > 0 ? sy / syy : 0;
+
+  fitted_ = true;
+  applied_temp_ = NAN;
+
+  LOG_I("thermal drift: %.2f - %.1f, %.5f mm/C at center, %.7f, %.7f mm/C/mm\n", tmin, tmax, coef_[0], coef_[1], coef_[2]);
+  return true;
+}
+
+
+uint32_t ThermalDrift::MeshSum() {
+  uint32_t sum = GRID_MAX_POINTS_X * GRID_MAX_NUM + GRID_MAX_POINTS_Y;
+
+  // shape only, offsetting the whole mesh for nozzle height doesn't make it new
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      sum = sum * 31 + (uint32_t)LROUND((z_values[x][y] - z_values[0][0]) * 1000);
+
+  return sum;
+}
+
+
+void ThermalDrift::SetMeshTemp(float temp) {
+  cfg.mesh_temp = temp;
+  cfg.mesh_sum = MeshSum();
+  applied_temp_ = NAN;
+}
+
+
+void ThermalDrift::Bake() {
+  // nothing was added, Capture() takes the new mesh at the bed temperature
+  if (!applied_)
+    return;
+
+  SetMeshTemp(applied_temp_);
+  // mesh has it now, Process() works out the drift from the new mesh temperature
+  Unapply();
+}
+
+
+void ThermalDrift::Capture() {
+  if (z_values[0][0] == DEFAUT_LEVELING_HEIGHT || z_values[0][0] == DEFAUT_LEVELING_HEIGHT_3DP2E)
+    return;
+
+  if (MeshSum() != cfg.mesh_sum) {
+    SetMeshTemp(thermalManager.degBed());
+    LOG_I("thermal drift: new mesh at %.1f\n", cfg.mesh_temp);
+  }
+}
+
+
+void ThermalDrift::Unapply() {
+  bilinear_drift[0] = bilinear_drift[1] = bilinear_drift[2] = 0;
+  applied_ = false;
+}
+
+
+void ThermalDrift::Process() {
+  if (PENDING(millis(), next_ms_))
+    return;
+  next_ms_ = millis() + 1000;
+
+  if (!fitted_ || !cfg.enabled || isnan(cfg.mesh_temp)) {
+    if (applied_)
+      Unapply();
+    return;
+  }
+
+  float tmin = 999, tmax = -999;
+  for (uint8_t i = 0; i < cfg.samples; i++) {
+    NOMORE(tmin, cfg.temp[i]);
+    NOLESS(tmax, cfg.temp[i]);
+  }
+
+  const float temp = constrain(thermalManager.degBed(), tmin - (THERMAL_DRIFT_RANGE), tmax + (THERMAL_DRIFT_RANGE));
+
+  if (applied_ && ABS(temp - applied_temp_) < THERMAL_DRIFT_STEP)
+    return;
+
+  // the mesh already has the shape at its own temperature
+  const float dt = temp - cfg.mesh_temp;
+
+  bilinear_drift[0] = (coef_[0] - coef_[1] * center_[0] - coef_[2] * center_[1]) * dt;
+  bilinear_drift[1] = coef_[1] * dt;
+  bilinear_drift[2] = coef_[2] * dt;
+
+  applied_ = true;
+  applied_temp_ = temp;
+}
+
+#endif // ENABLED(BED_THERMAL_DRIFT)
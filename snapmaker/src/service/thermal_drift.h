@@ -0,0 +1,95 @@
+/*
+ * Snapmaker2-Controller Firmware
+ * Copyright (C) 2019-2020 Snapmaker [https://github.com/Snapmaker]
+ *
+ * This file is part of Snapmaker2-Controller
+ * (see https://github.com/Snapmaker/Snapmaker2-Controller)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SNAPMAKER_THERMAL_DRIFT_H_
+#define SNAPMAKER_THERMAL_DRIFT_H_
+
+#include "../common/config.h"
+
+#include "src/inc/MarlinConfig.h"
+
+#if ENABLED(BED_THERMAL_DRIFT)
+
+// 4 corners and the center of the mesh
+#define THERMAL_DRIFT_POINTS  5
+
+// heights of the drift points probed at some bed temperatures
+typedef struct {
+  uint8_t  samples;
+  bool     enabled;
+  float    temp[THERMAL_DRIFT_TEMPS];                     // (°C) bed
+  float    x[THERMAL_DRIFT_POINTS];                       // (mm) where the points were probed
+  float    y[THERMAL_DRIFT_POINTS];
+  float    z[THERMAL_DRIFT_TEMPS][THERMAL_DRIFT_POINTS];  // (mm)
+  float    mesh_temp;                                     // (°C) bed when the mesh in use was probed, NAN if unknown
+  uint32_t mesh_sum;                                      // shape of that mesh
+} thermal_drift_t;
+
+class ThermalDrift {
+  public:
+    void Reset();
+
+    // called by M1036 after probing the points at current bed temperature
+    void AddSample(float temp, const float (&x)[THERMAL_DRIFT_POINTS],
+                   const float (&y)[THERMAL_DRIFT_POINTS], const float (&z)[THERMAL_DRIFT_POINTS]);
+
+    // fit dz/dT of each point, then a plane of them over the bed
+    bool Fit();
+
+    // called before saving settings, take bed temperature if the mesh is new
+    void Capture();
+
+    void SetMeshTemp(float temp);
+
+    // the drift in use was added to z_values, take them as a mesh at that temperature
+    void Bake();
+
+    // called in idle() of Marlin task, move the mesh with the bed temperature
+    void Process();
+
+    // where to probe point k of current grid
+    static void Point(uint8_t k, float &x, float &y);
+
+    bool fitted() { return fitted_; }
+
+    // (mm/°C) drift at center and its gradient
+    float slope(uint8_t i) { return coef_[i]; }
+
+  public:
+    thermal_drift_t cfg;  // saved by M500
+
+  private:
+    static uint32_t MeshSum();
+    void Unapply();
+
+  private:
+    bool fitted_ = false;
+    bool applied_ = false;
+    float coef_[3];       // dz/dT = coef_[0] + coef_[1] * (x - center_[0]) + coef_[2] * (y - center_[1])
+    float center_[2];
+    float applied_temp_;
+    millis_t next_ms_ = 0;
+};
+
+extern ThermalDrift thermal_drift;
+
+#endif // ENABLED(BED_THERMAL_DRIFT)
+
+#endif // #ifndef SNAPMAKER_THERMAL_DRIFT_H_
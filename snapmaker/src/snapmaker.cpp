@@ -27,6 +27,8 @@
 #include "service/system.h"
 #include "service/upgrade.h"
 #include "service/power_loss_recovery.h"
+#include "service/idle_nozzle_preheat.h"
+#include "service/temp_telemetry.h"
 
 // marlin headers
 #include "src/module/endstops.h"
@@ -170,6 +172,9 @@ static void main_loop(void *param) {
 
     advance_command_queue();
     quickstop.Process();
+    #if ENABLED(IDLE_NOZZLE_PREHEAT)
+      nozzle_preheat.Process();
+    #endif
     endstops.event_handler();
     idle();
 
@@ -227,6 +232,9 @@ static void hmi_task(void *param) {
     ret = hmi.CheckoutCmd(dispather_param.event_buff, dispather_param.size);
 
     systemservice.CheckIfSendWaitEvent();
+    #if ENABLED(HOTEND_TEMP_TELEMETRY)
+      temp_telemetry.CheckIfSendReport();
+    #endif
 
     if (ret == E_NO_RESRC) {
       // no command, sleep 10ms for next command
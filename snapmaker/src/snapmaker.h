@@ -49,6 +49,7 @@ extern SnapmakerHandle_t sm2_handle;
 
 #define EVENT_GROUP_MODULE_READY      (0x00000001)
 #define EVENT_GROUP_WAIT_FOR_HEATING  (0X00000002)
+#define EVENT_GROUP_TEMP_UPDATED      (0x00000004)
 
 
 #define ACTION_BAN_NONE               (0)
@@ -89,6 +89,19 @@ class RingBuffer {
     return &data[head_];
   }
 
+  // address of the element index places after head, NULL if not so many
+  T * PeekAddress(int32_t index) {
+    if (index >= Available()) {
+      return NULL;
+    }
+
+    index += head_;
+    if (index >= size_)
+      index -= size_;
+
+    return &data[index];
+  }
+
   T * TailAddress() {
     if (IsFull()) {
       return NULL;